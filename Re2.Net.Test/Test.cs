@@ -175,6 +175,79 @@ namespace Re2.Net.Test
                     Console.WriteLine("Running simple tests ...");
                     // Five matches, each with a value of "".
                     Debug.Assert(Regex.Matches("xxxx", "").Count == 5);
+                    Debug.Assert(Regex.Count("xxxx", "") == 5);
+                    Debug.Assert(Regex.Count("水𠜎", "") == 3);
+                    Debug.Assert(new rr.Regex("x").Count("xxxx", 1, 2) == 2);
+                    // Anchored searches.
+                    var digits = new rr.Regex(@"\d+");
+                    Debug.Assert(digits.IsFullMatch("12345") && !digits.IsFullMatch("123x5"));
+                    Debug.Assert(!digits.MatchAt("ab12", 1).Success && digits.MatchAt("ab12", 2).Value == "12");
+                    Debug.Assert(digits.Match("12 34", 0, 5, rr.RegexAnchor.Start).NextMatch() == Match.Empty);
+                    Debug.Assert(digits.Match("12 34", 3, 2, rr.RegexAnchor.Both).Value == "34");
+                    // LastMatch() searches backwards from the end of the input for the match that begins last.
+                    Debug.Assert(digits.LastMatch("12 34 水𠜎 56x").Index == 11);
+                    Debug.Assert(digits.LastMatch("12 34 水𠜎 56x").Value == "6");
+                    Debug.Assert(digits.LastMatch(new String('1', 1000) + "x").Length == 1);
+                    Debug.Assert(new rr.Regex("").LastMatch("水𠜎").Index == 3 && new rr.Regex("aa").LastMatch("aaaaa").Index == 3);
+                    // Past the first 256-byte window, where Matches() ends with the match at 298 instead.
+                    Debug.Assert(new rr.Regex("aa").LastMatch(new String('a', 301)).Index == 299 && Regex.Matches(new String('a', 301), "aa")[149].Index == 298);
+                    Debug.Assert(digits.LastMatch("7" + new String('x', 1000)).Index == 0);
+                    Debug.Assert(!digits.LastMatch("xxxx").Success);
+                    // Detached matches keep their values and groups, but not the input.
+                    var carMatch = new rr.Regex(@"(\w+)\s+(car)").Match("red car white car", 5).Detach();
+                    Debug.Assert(carMatch.Index == 8 && carMatch.Value == "white car");
+                    Debug.Assert(carMatch.Groups[1].Value == "white" && carMatch.Groups[2].Index == 14);
+                    Debug.Assert(carMatch.NextMatch() == Match.Empty);
+                    var detached = Regex.Matches(Encoding.UTF8.GetBytes("水 12 𠜎 34"), @"\d+").Detach();
+                    Debug.Assert(detached.Count == 2 && detached[1].Value == "34");
+                    // Capture accessors that don't create strings agree with Value.
+                    var wordMatch = Regex.Match(Encoding.UTF8.GetBytes("xx 水𠜎 yy"), @"\S+", rr.RegexOptions.None).NextMatch();
+                    Debug.Assert(wordMatch.ValueEquals("水𠜎") && !wordMatch.ValueEquals("水"));
+                    Debug.Assert(wordMatch.GetValueHashCode() == rr.Capture.GetValueHashCode(wordMatch.Value));
+                    Debug.Assert(wordMatch.ValueBytes.Offset == 3 && wordMatch.ValueBytes.Count == 7);
+                    var chars = new char[4];
+                    Debug.Assert(wordMatch.CopyTo(chars, 1) == 3 && new string(chars, 1, 3) == "水𠜎");
+                    Debug.Assert(carMatch.Groups[1].ValueEquals("white"));
+                    // Group names and numbers, including numbers as names.
+                    var named = new rr.Regex(@"(?P<year>\d{4})-(\d\d)");
+                    Debug.Assert(named.GroupNumberFromName("year") == 1 && named.GroupNumberFromName("2") == 2 && named.GroupNumberFromName("x") == -1);
+                    Debug.Assert(named.GroupNameFromNumber(1) == "year" && named.GroupNameFromNumber(2) == "2" && named.GroupNameFromNumber(3) == "");
+                    Debug.Assert(String.Join(",", named.GetGroupNames()) == "0,year,2" && named.GetGroupNumbers().Length == 3);
+                    Debug.Assert(named.Match("on 2014-05").Groups["year"].Value == "2014");
+                    // EnumerateMatches() yields the same matches as Matches(), and can be enumerated again.
+                    var stream = Regex.EnumerateMatches("a1b22c333", @"\d+");
+                    int streamed = 0;
+                    foreach(var m in stream)
+                        streamed += m.Length;
+                    Debug.Assert(streamed == 6 && System.Linq.Enumerable.Count(stream) == 3);
+                    // Each match may be disposed as soon as it has been used, before the next is asked for.
+                    int disposedLength = 0;
+                    var disposedStream = Regex.EnumerateMatches("a1b22c333", @"\d+");
+                    foreach(var m in disposedStream)
+                        using(m)
+                            disposedLength += m.Length;
+                    Debug.Assert(disposedLength == 6);
+                    // Every enumeration begins with the same first match, so once it is disposed the sequence can't be enumerated again.
+                    bool firstDisposed = false;
+                    try
+                    {
+                        System.Linq.Enumerable.Count(disposedStream);
+                    }
+                    catch(InvalidOperationException)
+                    {
+                        firstDisposed = true;
+                    }
+                    Debug.Assert(firstDisposed);
+                    var disposedIndexes = new List<int>();
+                    foreach(Match m in new rr.Regex(@"\d+").Matches("a1b22c333"))
+                        using(m)
+                            disposedIndexes.Add(m.Index);
+                    Debug.Assert(disposedIndexes.Count == 3 && disposedIndexes[2] == 6);
+                    // Multiline patterns beginning with '^' are only tried at line starts.
+                    Debug.Assert(Regex.Count("Twain\nx Twain\nTwain", "^Twain", rr.RegexOptions.Multiline) == 2);
+                    Debug.Assert(Regex.Matches("a\n\nb\n", "^$", rr.RegexOptions.Multiline)[1].Index == 5);
+                    Debug.Assert(Regex.Match("x\nabbc", "^ab*c", rr.RegexOptions.Multiline).Index == 2);
+                    Debug.Assert(Regex.Match("q\nx\nx\ny", @"^x[\s\S]*y", rr.RegexOptions.Multiline).Value == "x\nx\ny");
                     // Accessing an array (technically, the default Item property) with a negative index? Yup!
                     Debug.Assert(Regex.Matches("xxxx", "")[0].Groups[-1].Value == "");
                     // The returned Match containes a Group collection, and the first item in the Group collection is the Match.
@@ -204,6 +277,140 @@ namespace Re2.Net.Test
                     Debug.Assert(r.Match("𠜎水𠜱𠝹𠱓", 5).Index == 5);
                     Debug.Assert(r.Match("𠜎水𠜱𠝹𠱓", 5).Length == 4);
                     Debug.Assert(exception);
+                    // Capture buffers are reused between matches, so stale groups mustn't leak into the next match.
+                    var alt = new rr.Regex("(a)|(b)");
+                    Debug.Assert(alt.Match("a").Groups[1].Success);
+                    Debug.Assert(!alt.Match("b").Groups[1].Success);
+                    Debug.Assert(alt.Match("b").Groups[2].Value == "b");
+                    // Each chain of matches has a buffer of its own, so interleaved iterations don't disturb each other.
+                    var chainA = alt.Match("ab").NextMatch();
+                    var chainB = alt.Match("ba").NextMatch();
+                    Debug.Assert(chainB.Groups[1].Value == "a" && chainA.Groups[2].Value == "b" && !chainA.Groups[1].Success);
+                    // TryMatch() writes (index, length) pairs, with -1 for groups that didn't take part.
+                    var offsets = new int[6];
+                    Debug.Assert(alt.TryMatch("xxb", 0, offsets));
+                    Debug.Assert(offsets[0] == 2 && offsets[1] == 1 && offsets[2] == -1 && offsets[4] == 2 && offsets[5] == 1);
+                    Debug.Assert(!alt.TryMatch(Encoding.ASCII.GetBytes("xxx"), 0, offsets));
+                    Debug.Assert(r.TryMatch("𠜎水𠜱𠝹𠱓", 0, offsets) && offsets[0] == 5 && offsets[1] == 4);
+                    // Empty matches step over whole characters, surrogate pairs included.
+                    Debug.Assert(Regex.Matches("水𠜎", "").Count == 3);
+                    Debug.Assert(Regex.Matches("水𠜎", "")[2].Index == 3);
+                    // MatchOffsets() finds the same matches as Matches(), a buffer at a time.
+                    var empty = new rr.Regex("");
+                    int next = 0, found = 0;
+                    while(next >= 0)
+                        found += empty.MatchOffsets("水𠜎", next, new int[2], out next);
+                    Debug.Assert(found == 3);
+                    Debug.Assert(new rr.Regex(@"(\w+)\s+(car)").MatchOffsets("red car white car", new int[12]) == 2);
+                    // Single-byte encodings reject characters outside their range, whatever the input length.
+                    Debug.Assert(new rr.Regex("é", rr.RegexOptions.Latin1).IsMatch(new String('x', 1000) + "é"));
+                    exception = false;
+                    try
+                    {
+                        new rr.Regex("x", rr.RegexOptions.ASCII).IsMatch(new String('x', 1000) + "é");
+                    }
+                    catch(ArgumentOutOfRangeException)
+                    {
+                        exception = true;
+                    }
+                    Debug.Assert(exception);
+                    // Disposing a match releases its input, but what has already been found stays readable.
+                    var disposed = new rr.Regex(@"(\w+)").Match("red car");
+                    var word = disposed.Groups[1];
+                    disposed.Dispose();
+                    Debug.Assert(disposed.Value == "red" && word.Value == "red");
+                    exception = false;
+                    try
+                    {
+                        disposed.NextMatch();
+                    }
+                    catch(ObjectDisposedException)
+                    {
+                        exception = true;
+                    }
+                    Debug.Assert(exception);
+                    // The input stays alive while any match found in it is undisposed.
+                    var first = new rr.Regex(@"\w+").Match("red car");
+                    var second = first.NextMatch();
+                    first.Dispose();
+                    Debug.Assert(second.NextMatch() == Match.Empty);
+                    // Byte arrays above ByteCopyThreshold are pinned for each search instead of copied, with the same results.
+                    var cars = Encoding.ASCII.GetBytes("red car white car");
+                    var threshold = rr.Regex.ByteCopyThreshold;
+                    rr.Regex.ByteCopyThreshold = 0;
+                    Debug.Assert(Regex.Matches(cars, "car").Count == 2 && Regex.Matches(cars, "car")[1].Groups[0].Index == 14);
+                    Debug.Assert(Regex.Matches(new byte[0], "").Count == 1);
+                    rr.Regex.ByteCopyThreshold = threshold;
+                    Debug.Assert(Regex.Matches(cars, "car").Count == 2 && Regex.Matches(cars, "car")[1].Groups[0].Index == 14);
+                    // Native memory is searched in place, and handed back through the callback once no match needs it.
+                    var native = System.Runtime.InteropServices.Marshal.AllocHGlobal(cars.Length);
+                    System.Runtime.InteropServices.Marshal.Copy(cars, 0, native, cars.Length);
+                    var released = 0;
+                    var onNative = new rr.Regex("(c)ar").Matches(native, cars.Length, () => released++);
+                    Debug.Assert(onNative.Count == 2 && onNative[1].Index == 14 && onNative[1].Groups[1].Value == "c");
+                    Debug.Assert(onNative[1].LongIndex == 14 && onNative[1].Groups[1].LongLength == 1);
+                    Debug.Assert(new rr.Regex("white").IsMatch(native, cars.Length));
+                    onNative.Dispose();
+                    Debug.Assert(released == 1);
+                    new rr.Regex("blue").Match(native, cars.Length, () => released++);
+                    Debug.Assert(released == 2);
+                    System.Runtime.InteropServices.Marshal.FreeHGlobal(native);
+                    // Segmented input is searched in place, with matches that cross a boundary found in between.
+                    var segments = new[] { new ArraySegment<byte>(Encoding.ASCII.GetBytes("xxred c"), 2, 5), new ArraySegment<byte>(Encoding.ASCII.GetBytes("ar white car")) };
+                    var onSegments = new rr.Regex("(c)ar").Matches(segments, 8);
+                    Debug.Assert(onSegments.Count == 2 && onSegments[0].Index == 4 && onSegments[1].Index == 14 && onSegments[1].Groups[1].Value == "c");
+                    var bytewise = new List<ArraySegment<byte>>();
+                    foreach(var b in Encoding.ASCII.GetBytes("red carwhite car"))
+                        bytewise.Add(new ArraySegment<byte>(new[] { b }));
+                    var onBytewise = new rr.Regex(@"\bcar\b").Matches(bytewise, 3);
+                    Debug.Assert(onBytewise.Count == 1 && onBytewise[0].Index == 13);
+                    Debug.Assert(new rr.Regex("").Matches(bytewise, 1).Count == 17);
+                    // Char arrays and StringBuilders are transcoded in place, with the same indices and values as the string they hold.
+                    var carChars = "xx red car white car".ToCharArray();
+                    var onChars = new rr.Regex("(c)ar").Matches(new ArraySegment<char>(carChars, 3, carChars.Length - 3));
+                    Debug.Assert(onChars.Count == 2 && onChars[1].Index == 14 && onChars[1].Groups[1].Value == "c" && onChars[1].ValueEquals("car"));
+                    Debug.Assert(new rr.Regex("white").IsMatch(carChars) && !new rr.Regex("^red").IsMatch(carChars));
+                    var builder = new StringBuilder(new string('x', 4095)).Append("\U0001F697 car");
+                    var onBuilder = new rr.Regex("\U0001F697 (c)ar").Match(builder);
+                    Debug.Assert(onBuilder.Index == 4095 && onBuilder.Length == 6 && onBuilder.Groups[1].Index == 4098);
+                    Debug.Assert(onBuilder.Value == "\U0001F697 car" && onBuilder.GetValueHashCode() == rr.Capture.GetValueHashCode("\U0001F697 car"));
+                    // A high surrogate at the very end has no partner, and counts as one char.
+                    Debug.Assert(new rr.Regex("x").IsMatch(new[] { 'x', '\uD83D' }) && new rr.Regex("$").Match("ab\uD83D").Index == 3);
+                    Debug.Assert(new rr.Regex("$").Match(new StringBuilder("car\uD83D")).Index == 4);
+                    Debug.Assert(new rr.Regex("car").Matches(builder).Count == 1 && new rr.Regex("x car").IsMatch(new StringBuilder("x car")));
+                    // Files are mapped and searched in place, with file offsets as indices, and closed once the matches are disposed.
+                    var path = System.IO.Path.GetTempFileName();
+                    System.IO.File.WriteAllBytes(path, cars);
+                    var inFile = new rr.Regex("(c)ar").MatchesInFile(path);
+                    Debug.Assert(inFile.Count == 2 && inFile[1].LongIndex == 14 && inFile[1].Groups[1].Value == "c");
+                    Debug.Assert(new rr.Regex("white").IsMatchInFile(path) && !new rr.Regex("blue").IsMatchInFile(path));
+                    inFile.Dispose();
+                    using(new System.IO.FileStream(path, System.IO.FileMode.Open, System.IO.FileAccess.ReadWrite, System.IO.FileShare.None)) { }
+                    System.IO.File.WriteAllBytes(path, new byte[0]);
+                    Debug.Assert(new rr.Regex("").MatchesInFile(path).Count == 1);
+                    System.IO.File.Delete(path);
+                    // Streams are read a chunk at a time, with matches that cross a chunk boundary still found.
+                    var fromStream = new rr.Regex("(c)ar").MatchesAsync(new System.IO.MemoryStream(cars), 4, 8).Result;
+                    Debug.Assert(fromStream.Count == 2 && fromStream[0].LongIndex == 4 && fromStream[1].LongIndex == 14 && fromStream[1].Groups[1].Value == "c");
+                    var asyncIndexes = new List<long>();
+                    Debug.Assert(new rr.Regex(@"\w+").MatchesAsync(new System.IO.MemoryStream(cars), 3, 5, m => asyncIndexes.Add(m.LongIndex)).Result == 4);
+                    Debug.Assert(asyncIndexes.Count == 4 && asyncIndexes[3] == 14);
+                    // A scanner reports each match once the input after it is known, without searching earlier input again.
+                    var scanner = new rr.RegexScanner(new rr.Regex(@"car\b"), 4);
+                    Debug.Assert(scanner.Append(Encoding.ASCII.GetBytes("red c")).Length == 0);
+                    var settled = scanner.Append(Encoding.ASCII.GetBytes("ar white car"));
+                    Debug.Assert(settled.Length == 1 && settled[0].LongIndex == 4 && scanner.Position >= 7 && scanner.Length == 17);
+                    var last = scanner.Finish();
+                    Debug.Assert(last.Length == 1 && last[0].LongIndex == 14 && last[0].Value == "car" && scanner.Finish().Length == 0);
+                    // Line mode reports (line number, index, length) per matching line, with '$' anchored at each line's end.
+                    var log = "red car\nblue bike\nwhite car\n";
+                    var lineHits = new int[9];
+                    Debug.Assert(new rr.Regex("car$").MatchLines(log, lineHits) == 2 && lineHits[0] == 1 && lineHits[1] == 0 && lineHits[2] == 7);
+                    Debug.Assert(lineHits[3] == 3 && lineHits[4] == 18 && lineHits[5] == 9);
+                    Debug.Assert(new rr.Regex("car").MatchLines(log, lineHits, true) == 1 && lineHits[0] == 2 && lineHits[1] == 8);
+                    Debug.Assert(new rr.Regex("car").MatchLines(Encoding.ASCII.GetBytes(log), new int[3]) == 1);
+                    Debug.Assert(new rr.Regex("car").CountLines(log) == 2 && new rr.Regex("car").CountLines(log, true, 10) == 1 && new rr.Regex("e").CountLines(log, false, 2) == 2);
+                    Debug.Assert(new rr.Regex("car").MatchLines("\u00e9\n\U0001F697 car", lineHits) == 1 && lineHits[0] == 2 && lineHits[1] == 2 && lineHits[2] == 6);
                     Console.WriteLine("\t... Success.\n");
                 }
 
@@ -363,6 +570,118 @@ namespace Re2.Net.Test
                     PrintStringVsStringResults(testcases);
 
                     Console.WriteLine("\n\t... Success.\n");
+
+                    Console.Write("\n\n\tRunning 'Count' test...\n\n");
+
+                    var counts = new StringBuilder("Regular Expression|Count()|Matches().Count|Speedup\n---|---:|---:|---:");
+                    foreach(var testcase in testcases)
+                    {
+                        var re2s = new rr.Regex(testcase.Pattern, rr.RegexOptions.Multiline);
+
+                        watch.Start();
+                        var count = re2s.Count(haystring);
+                        var countTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        watch.Start();
+                        var matchesCount = re2s.Matches(haystring).Count;
+                        var matchesTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        Debug.Assert(count == matchesCount);
+
+                        counts.Append(
+                            String.Format("\n<code>{0}</code>|{1} ms|{2} ms|**{3}x**",
+                                           testcase.Pattern.Replace("|", "&#124;").Replace("](", @"]\("),
+                                           countTime.ToString(GetDoubleFormatString(countTime)),
+                                           matchesTime.ToString(GetDoubleFormatString(matchesTime)),
+                                           (matchesTime/countTime).ToString("0.0")
+                            )
+                        );
+                    }
+                    Console.WriteLine(counts.ToString());
+
+                    Console.WriteLine("\n\t... Success.\n");
+
+                    Console.Write("\n\n\tRunning 'Transcoding' test...\n\n");
+
+                    // Short inputs are transcoded into inline storage, long ones into pooled blocks. Steady growth in
+                    // private bytes over the repeated rounds would point to native heap fragmentation.
+                    var transcoding = new StringBuilder("Input|Calls|IsMatch()|Match()|Gen 0 GCs|Private bytes delta\n---|---:|---:|---:|---:|---:");
+                    var calls = 100000;
+                    foreach(var length in new int[] { 32, 1024, 65536 })
+                    {
+                        var input = haystring.Substring(0, length);
+                        var re2s  = new rr.Regex("Twain|Sawyer");
+                        var process = Process.GetCurrentProcess();
+                        var gen0 = GC.CollectionCount(0);
+                        process.Refresh();
+                        var privateBytes = process.PrivateMemorySize64;
+
+                        watch.Start();
+                        for(int i = 0; i < calls; i++)
+                            re2s.IsMatch(input);
+                        var isMatchTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        watch.Start();
+                        for(int i = 0; i < calls; i++)
+                            re2s.Match(input);
+                        var matchTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        process.Refresh();
+                        transcoding.Append(
+                            String.Format("\n{0} chars|{1}|{2} ms|{3} ms|{4}|{5:N0}",
+                                           length,
+                                           calls,
+                                           isMatchTime.ToString(GetDoubleFormatString(isMatchTime)),
+                                           matchTime.ToString(GetDoubleFormatString(matchTime)),
+                                           GC.CollectionCount(0) - gen0,
+                                           process.PrivateMemorySize64 - privateBytes
+                            )
+                        );
+                    }
+                    Console.WriteLine(transcoding.ToString());
+
+                    Console.WriteLine("\n\t... Success.\n");
+
+                    Console.Write("\n\n\tRunning 'Disposal' test...\n\n");
+
+                    // Matches are kept in a rolling window so that they live long enough to be promoted, as they would in a
+                    // service that queues its results. Undisposed inputs are released by the finalizer thread instead.
+                    var disposal = new StringBuilder("Matches|Time|Gen 0 GCs|Gen 1 GCs|Gen 2 GCs\n---|---:|---:|---:|---:");
+                    foreach(var dispose in new bool[] { false, true })
+                    {
+                        var input  = haystring.Substring(0, 1024);
+                        var re2s   = new rr.Regex("Twain|Sawyer|the");
+                        var window = new rr.Match[4096];
+                        var gens   = new int[] { GC.CollectionCount(0), GC.CollectionCount(1), GC.CollectionCount(2) };
+
+                        watch.Start();
+                        for(int i = 0; i < calls; i++)
+                        {
+                            var slot = i % window.Length;
+                            if(dispose && window[slot] != null)
+                                window[slot].Dispose();
+                            window[slot] = re2s.Match(input);
+                        }
+                        var disposalTime = TimerTicksToMilliseconds(watch.ElapsedTicks);
+                        watch.Reset();
+
+                        disposal.Append(
+                            String.Format("\n{0}|{1} ms|{2}|{3}|{4}",
+                                           dispose ? "Disposed" : "Finalized",
+                                           disposalTime.ToString(GetDoubleFormatString(disposalTime)),
+                                           GC.CollectionCount(0) - gens[0],
+                                           GC.CollectionCount(1) - gens[1],
+                                           GC.CollectionCount(2) - gens[2]
+                            )
+                        );
+                    }
+                    Console.WriteLine(disposal.ToString());
+
+                    Console.WriteLine("\n\t... Success.\n");
                 }
             }
             catch(Exception ex)
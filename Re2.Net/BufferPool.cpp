@@ -0,0 +1,76 @@
+﻿/*
+ *  Re2.Net Copyright ©2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#pragma managed(push, off)
+    #include <stdlib.h>
+    #include <intrin.h>
+#pragma managed(pop)
+
+#include "BufferPool.h"
+
+
+namespace Re2
+{
+namespace Net
+{
+    #pragma managed(push, off)
+
+    void* volatile BufferPool::_slots[BufferPool::Classes][BufferPool::Slots];
+
+
+    char* BufferPool::Rent(size_t size)
+    {
+        int sizeClass = 0;
+        while(sizeClass < Classes && (static_cast<size_t>(1) << (MinShift + sizeClass)) < size)
+            ++sizeClass;
+
+        if(Classes == sizeClass)
+        {
+            Header* block = static_cast<Header*>(malloc(sizeof(Header) + size));
+            if(!block)
+                return NULL;
+
+            block->sizeClass = Oversized;
+            return reinterpret_cast<char*>(block + 1);
+        }
+
+        for(int i = 0; i < Slots; i++)
+        {
+            Header* block = static_cast<Header*>(_InterlockedExchangePointer(&_slots[sizeClass][i], NULL));
+            if(block)
+                return reinterpret_cast<char*>(block + 1);
+        }
+
+        Header* block = static_cast<Header*>(malloc(sizeof(Header) + (static_cast<size_t>(1) << (MinShift + sizeClass))));
+        if(!block)
+            return NULL;
+
+        block->sizeClass = sizeClass;
+        return reinterpret_cast<char*>(block + 1);
+    }
+
+
+    void BufferPool::Return(char* buffer)
+    {
+        if(!buffer)
+            return;
+
+        Header* block = reinterpret_cast<Header*>(buffer) - 1;
+        if(Oversized != block->sizeClass)
+        {
+            for(int i = 0; i < Slots; i++)
+                if(!_InterlockedCompareExchangePointer(&_slots[block->sizeClass][i], block, NULL))
+                    return;
+        }
+
+        free(block);
+    }
+
+    #pragma managed(pop)
+}
+}
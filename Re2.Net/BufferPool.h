@@ -0,0 +1,64 @@
+﻿/*
+ *  Re2.Net Copyright ©2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#pragma managed(push, off)
+    #include <stddef.h>
+#pragma managed(pop)
+
+
+namespace Re2
+{
+namespace Net
+{
+    #pragma managed(push, off)
+
+    /*
+     *  Every String input has to be transcoded into a native buffer before RE2 can search it, and
+     *  at high call rates malloc() and free() for each one churn and fragment the native heap.
+     *  BufferPool hands out blocks in power-of-two size classes from 256 bytes to 1 MB, and keeps a
+     *  few returned blocks of each class for reuse. Larger blocks go straight to malloc() and free().
+     *
+     *  The cached blocks sit in slots that are claimed and filled with interlocked exchanges, so any
+     *  thread can rent or return without locking; when every slot of a class is empty a new block is
+     *  allocated, and when every slot is full a returned block is freed.
+     */
+    class BufferPool
+    {
+        public:
+
+            /* Returns a block of at least size bytes, or NULL if memory is exhausted. */
+            static char* Rent(size_t size);
+
+            /* Returns a block obtained from Rent(). NULL is ignored. */
+            static void Return(char* buffer);
+
+
+        private:
+
+            enum
+            {
+                MinShift  = 8,
+                MaxShift  = 20,
+                Classes   = MaxShift - MinShift + 1,
+                Slots     = 4,
+                Oversized = -1
+            };
+
+            /* Precedes each block, recording its size class. Padded to keep the data 16-byte aligned. */
+            struct Header
+            {
+                int sizeClass;
+                int padding[3];
+            };
+
+            static void* volatile _slots[Classes][Slots];
+    };
+
+    #pragma managed(pop)
+}
+}
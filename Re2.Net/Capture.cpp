@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <vcclr.h>
 #include "Capture.h"
 #include "RegexInput.h"
 
@@ -14,7 +15,7 @@ namespace Re2
 {
 namespace Net
 {
-    Capture::Capture(RegexInput^ input, int index, int length)
+    Capture::Capture(RegexInput^ input, Int64 index, Int64 length)
     {
         _input  = input;
         _index  = index;
@@ -28,30 +29,258 @@ namespace Net
 
     int Capture::Index::get()
     {
-        return _index;
+        if(_index > Int32::MaxValue)
+            throw gcnew OverflowException("The index is too large for an Int32; use LongIndex.");
+        return static_cast<int>(_index);
     }
 
     int Capture::Length::get()
+    {
+        if(_length > Int32::MaxValue)
+            throw gcnew OverflowException("The length is too large for an Int32; use LongLength.");
+        return static_cast<int>(_length);
+    }
+
+    Int64 Capture::LongIndex::get()
+    {
+        return _index;
+    }
+
+    Int64 Capture::LongLength::get()
     {
         return _length;
     }
 
+    /*
+     *  Returns the first byte of a byte input's value, which pinned keeps in place for managed arrays.
+     *  Managed arrays and Strings are bounded by Int32, so only caller memory needs 64-bit arithmetic.
+     */
+    const unsigned char* Capture::_valueBytes(unsigned char* pinned)
+    {
+        Int64 index = _index - _input->Origin;
+        return _input->Bytes ? pinned + index : (const unsigned char*)_input->Data + index;
+    }
+
     String^ Capture::Value::get()
     {
-        if(_input->Bytes)
+        /* Detached inputs hold only the text of one match, starting at Origin. */
+        int length = this->Length;
+
+        if(!_input->IsByteInput)
+            return _input->Substring(static_cast<int>(_index - _input->Origin), length);
+        if(!length)
+            return String::Empty;
+
+        pin_ptr<Byte> pinned = _input->Bytes ? &_input->Bytes[0] : nullptr;
+        Byte*         bytes  = const_cast<Byte*>(this->_valueBytes(pinned));
+
+        return _input->IsUTF8 ? _utf8Encoding->GetString(bytes, length) : _latin1Encoding->GetString(bytes, length);
+    }
+
+    /*
+     *  Returns the first char of a text input's value, which the caller pins. Strings and char arrays are
+     *  read in place; a StringBuilder can't be pinned, so its value is copied out of it first.
+     */
+    interior_ptr<const wchar_t> Capture::_valueChars()
+    {
+        int index = static_cast<int>(_index - _input->Origin);
+
+        if(_input->Chars)
+            return &_input->Chars[_input->CharStart + index];
+        if(_input->Builder)
+            return PtrToStringChars(_input->Builder->ToString(index, this->Length));
+
+        return PtrToStringChars(_input->Input) + index;
+    }
+
+    String^ Capture::ToString()
+    {
+        return this->Value;
+    }
+
+    /* FNV-1a, folded over UTF-16 code units. */
+    static unsigned int HashChars(unsigned int hash, const wchar_t* chars, int length)
+    {
+        for(int i = 0; i < length; i++)
         {
-            if(_input->IsUTF8)
-                return _utf8Encoding->GetString(_input->Bytes, _index, _length);
-            else
-                return _latin1Encoding->GetString(_input->Bytes, _index, _length);
+            hash ^= chars[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    static const unsigned int HashSeed = 2166136261u;
+
+    /*
+     *  Decodes the next chunk of a byte input into buffer, advancing position. Latin-1 is widened byte by
+     *  byte; UTF-8 goes through decoder, which substitutes "?" exactly as Value does.
+     */
+    int Capture::_decodeChunk(Decoder^ decoder, const unsigned char* bytes, int* position, int end, wchar_t* buffer)
+    {
+        if(!decoder)
+        {
+            int count = end - *position < _bufferLength ? end - *position : _bufferLength;
+            for(int i = 0; i < count; i++)
+                buffer[i] = bytes[*position + i];
+
+            *position += count;
+            return count;
         }
+
+        int  bytesUsed;
+        int  charsUsed;
+        bool completed;
+        decoder->Convert(const_cast<unsigned char*>(bytes) + *position, end - *position, buffer, _bufferLength, true, bytesUsed, charsUsed, completed);
+
+        *position += bytesUsed;
+        return charsUsed;
+    }
+
+    Decoder^ Capture::_rentDecoder()
+    {
+        if(!_input->IsUTF8)
+            return nullptr;
+
+        Decoder^ decoder = _utf8Decoder;
+        if(!decoder)
+            _utf8Decoder = decoder = _utf8Encoding->GetDecoder();
         else
-            return _input->Input->Substring(_index, _length);
+            decoder->Reset();
+
+        return decoder;
     }
 
-    String^ Capture::ToString()
+    bool Capture::ValueEquals(String^ value)
     {
-        return this->Value;
+        if(!value)
+            throw gcnew ArgumentNullException("value", "Value cannot be null.");
+
+        if(!_input->IsByteInput)
+        {
+            if(value->Length != _length)
+                return false;
+            if(!_length)
+                return true;
+
+            pin_ptr<const wchar_t> chars = this->_valueChars();
+            pin_ptr<const wchar_t> other = PtrToStringChars(value);
+            return !memcmp(chars, other, value->Length * sizeof(wchar_t));
+        }
+
+        /* A byte never decodes to more than one UTF-16 code unit, so a longer value can't match. */
+        if(value->Length > _length)
+            return false;
+        if(!_length)
+            return !value->Length;
+
+        Decoder^               decoder = this->_rentDecoder();
+        pin_ptr<Byte>          pinned  = _input->Bytes ? &_input->Bytes[0] : nullptr;
+        const unsigned char*   bytes   = this->_valueBytes(pinned);
+        pin_ptr<const wchar_t> chars   = PtrToStringChars(value);
+        wchar_t                buffer[_bufferLength];
+        int                    length   = this->Length;
+        int                    position = 0;
+        int                    compared = 0;
+
+        while(position < length)
+        {
+            int count = _decodeChunk(decoder, bytes, &position, length, buffer);
+            if(compared + count > value->Length || memcmp(buffer, chars + compared, count * sizeof(wchar_t)))
+                return false;
+
+            compared += count;
+        }
+
+        return compared == value->Length;
+    }
+
+    int Capture::CopyTo(array<Char>^ destination, int destinationIndex)
+    {
+        if(!destination)
+            throw gcnew ArgumentNullException("destination", "Value cannot be null.");
+        if(destinationIndex < 0 || destinationIndex > destination->Length)
+            throw gcnew ArgumentOutOfRangeException("destinationIndex", "Destination index cannot be less than 0 or greater than destination length.");
+
+        int length = this->Length;
+
+        if(!_input->IsByteInput)
+        {
+            if(destination->Length - destinationIndex < length)
+                throw gcnew ArgumentException("Destination is too short to hold the value.", "destination");
+
+            _input->CopyChars(static_cast<int>(_index - _input->Origin), destination, destinationIndex, length);
+            return length;
+        }
+
+        if(!length)
+            return 0;
+
+        Decoder^             decoder = this->_rentDecoder();
+        pin_ptr<Byte>        pinned  = _input->Bytes ? &_input->Bytes[0] : nullptr;
+        const unsigned char* bytes   = this->_valueBytes(pinned);
+        wchar_t              buffer[_bufferLength];
+        int                  position = 0;
+        int                  copied   = 0;
+
+        while(position < length)
+        {
+            int count = _decodeChunk(decoder, bytes, &position, length, buffer);
+            if(destination->Length - destinationIndex - copied < count)
+                throw gcnew ArgumentException("Destination is too short to hold the value.", "destination");
+
+            for(int i = 0; i < count; i++)
+                destination[destinationIndex + copied + i] = buffer[i];
+
+            copied += count;
+        }
+
+        return copied;
+    }
+
+    ArraySegment<Byte> Capture::ValueBytes::get()
+    {
+        if(!_input->Bytes)
+            throw gcnew InvalidOperationException("ValueBytes is only available for byte array inputs.");
+
+        return ArraySegment<Byte>(_input->Bytes, static_cast<int>(_index - _input->Origin), static_cast<int>(_length));
+    }
+
+    int Capture::GetValueHashCode()
+    {
+        if(!_length)
+            return static_cast<int>(HashSeed);
+
+        int length = this->Length;
+
+        if(!_input->IsByteInput)
+        {
+            pin_ptr<const wchar_t> chars = this->_valueChars();
+            return static_cast<int>(HashChars(HashSeed, chars, length));
+        }
+
+        Decoder^             decoder = this->_rentDecoder();
+        pin_ptr<Byte>        pinned  = _input->Bytes ? &_input->Bytes[0] : nullptr;
+        const unsigned char* bytes   = this->_valueBytes(pinned);
+        wchar_t              buffer[_bufferLength];
+        int                  position = 0;
+        unsigned int         hash     = HashSeed;
+
+        while(position < length)
+        {
+            int count = _decodeChunk(decoder, bytes, &position, length, buffer);
+            hash = HashChars(hash, buffer, count);
+        }
+
+        return static_cast<int>(hash);
+    }
+
+    int Capture::GetValueHashCode(String^ value)
+    {
+        if(!value)
+            throw gcnew ArgumentNullException("value", "Value cannot be null.");
+
+        pin_ptr<const wchar_t> chars = PtrToStringChars(value);
+        return static_cast<int>(HashChars(HashSeed, chars, value->Length));
     }
 }
 }
\ No newline at end of file
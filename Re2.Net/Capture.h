@@ -28,6 +28,22 @@ namespace Net
             static initonly Encoding^ _utf8Encoding   = (Encoding^)Encoding::UTF8->Clone();
             static initonly Encoding^ _latin1Encoding = (Encoding^)Encoding::GetEncoding("ISO-8859-1")->Clone();
 
+            /*
+             *  Decoders carry state between calls, so each thread gets its own. They let the accessors
+             *  below read UTF-8 values a stack buffer at a time without allocating.
+             */
+            [ThreadStatic] static Decoder^ _utf8Decoder;
+
+            literal int _bufferLength = 256;
+
+            static int _decodeChunk(Decoder^ decoder, const unsigned char* bytes, int* position, int end, wchar_t* buffer);
+
+            Decoder^ _rentDecoder();
+
+            const unsigned char* _valueBytes(unsigned char* pinned);
+
+            interior_ptr<const wchar_t> _valueChars();
+
             static Capture()
             {
                 /*
@@ -43,11 +59,11 @@ namespace Net
 
         internal:
 
-            int         _index;
-            int         _length;
+            Int64       _index;
+            Int64       _length;
             RegexInput^ _input;
 
-            Capture(RegexInput^ input, int i, int l);
+            Capture(RegexInput^ input, Int64 i, Int64 l);
 
             property RegexInput^ Input { RegexInput^ get(); }
 
@@ -60,7 +76,23 @@ namespace Net
             /// <value>
             ///     The zero-based position in the input where the first character of the captured subexpression is found.
             /// </value>
+            /// <exception cref="System::OverflowException">
+            ///     The position is greater than <see cref="Int32::MaxValue"/>, which is only possible in native memory. Use
+            ///     <see cref="LongIndex"/> instead.
+            /// </exception>
             property int Index { int get(); }
+
+            /// <summary>
+            ///     Gets the position in the input where the first character of the captured subexpression is found, as a 64-bit integer.
+            /// </summary>
+            /// <value>
+            ///     The zero-based position in the input where the first character of the captured subexpression is found.
+            /// </value>
+            /// <remarks>
+            ///     Inputs in native memory can be larger than 2 GB, and captures within them can begin beyond the range of
+            ///     <see cref="Index"/>.
+            /// </remarks>
+            property Int64 LongIndex { Int64 get(); }
             
             /// <summary>
             ///     Gets the length of the captured subexpression.
@@ -71,8 +103,19 @@ namespace Net
             /// <remarks>
             ///     <c>Length</c> is given in characters, if the input is a string, or bytes, if the input is a byte array.
             /// </remarks>
+            /// <exception cref="System::OverflowException">
+            ///     The length is greater than <see cref="Int32::MaxValue"/>. Use <see cref="LongLength"/> instead.
+            /// </exception>
             property int Length { int get(); }
 
+            /// <summary>
+            ///     Gets the length of the captured subexpression, as a 64-bit integer.
+            /// </summary>
+            /// <value>
+            ///     The length of the captured subexpression.
+            /// </value>
+            property Int64 LongLength { Int64 get(); }
+
             /// <summary>
             ///     Gets the captured subexpression as a string.
             /// </summary>
@@ -95,6 +138,67 @@ namespace Net
             ///     <c>ToString</c> is actually an internal call to the <see cref="Value"/> property.
             /// </remarks>
             virtual String^ ToString() override;
+
+            /// <summary>
+            ///     Determines whether the captured subexpression is equal to the specified string, without creating a string from it.
+            /// </summary>
+            /// <param name="value">The string to compare to the captured subexpression.</param>
+            /// <returns><c>true</c> if <see cref="Value"/> would equal <paramref name="value"/> (ordinal comparison); otherwise, <c>false</c>.</returns>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="value"/> is <c>null</c>.
+            /// </exception>
+            bool ValueEquals(String^ value);
+
+            /// <summary>
+            ///     Copies the captured subexpression into a character array, without creating a string from it.
+            /// </summary>
+            /// <param name="destination">The array to copy the characters to.</param>
+            /// <param name="destinationIndex">The index in <paramref name="destination"/> at which copying begins.</param>
+            /// <returns>The number of characters copied, which is the length of <see cref="Value"/>.</returns>
+            /// <exception cref="System::ArgumentException">
+            ///     <paramref name="destination"/> doesn't have room for the value after <paramref name="destinationIndex"/>.
+            /// </exception>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="destination"/> is <c>null</c>.
+            /// </exception>
+            /// <exception cref="System::ArgumentOutOfRangeException">
+            ///     <paramref name="destinationIndex"/> is less than zero or greater than the length of <paramref name="destination"/>.
+            /// </exception>
+            int CopyTo(array<Char>^ destination, int destinationIndex);
+
+            /// <summary>
+            ///     Gets the bytes of the captured subexpression, without copying them.
+            /// </summary>
+            /// <value>
+            ///     A segment of the input byte array holding the captured subexpression.
+            /// </value>
+            /// <remarks>
+            ///     The segment refers to the input itself, so changes to the input array are visible through it.
+            /// </remarks>
+            /// <exception cref="System::InvalidOperationException">
+            ///     The input is a string or a block of native memory rather than a byte array.
+            /// </exception>
+            property ArraySegment<Byte> ValueBytes { ArraySegment<Byte> get(); }
+
+            /// <summary>
+            ///     Returns a hash code for the captured subexpression, without creating a string from it.
+            /// </summary>
+            /// <returns>The 32-bit FNV-1a hash of the UTF-16 code units of <see cref="Value"/>.</returns>
+            /// <remarks>
+            ///     Unlike <c>String.GetHashCode()</c>, the result is the same in every process. Strings can be hashed the same way
+            ///     with <see cref="GetValueHashCode(String^)"/>, so captures can be looked up among strings by hash.
+            /// </remarks>
+            int GetValueHashCode();
+
+            /// <summary>
+            ///     Returns the hash code that <see cref="GetValueHashCode()"/> returns for a capture with the specified value.
+            /// </summary>
+            /// <param name="value">The string to hash.</param>
+            /// <returns>The 32-bit FNV-1a hash of the UTF-16 code units of <paramref name="value"/>.</returns>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="value"/> is <c>null</c>.
+            /// </exception>
+            static int GetValueHashCode(String^ value);
     };
 }
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+﻿/*
+ *  Re2.Net Copyright ©2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#include "CaptureBuffer.h"
+
+
+namespace Re2
+{
+namespace Net
+{
+    using System::Threading::Interlocked;
+
+    CaptureBuffer::CaptureBuffer(int count)
+        : _count(count), _slot(IntPtr::Zero)
+    { }
+
+    StringPiece* CaptureBuffer::Rent()
+    {
+        IntPtr captures = Interlocked::Exchange(_slot, IntPtr::Zero);
+        if(IntPtr::Zero != captures)
+            return static_cast<StringPiece*>(captures.ToPointer());
+
+        return new StringPiece[_count]();
+    }
+
+    void CaptureBuffer::Return(StringPiece* captures)
+    {
+        /* If another search returned its array first, this one is surplus. */
+        if(IntPtr::Zero != Interlocked::CompareExchange(_slot, IntPtr(captures), IntPtr::Zero))
+            delete[] captures;
+    }
+
+    CaptureBuffer::~CaptureBuffer()
+    {
+        this->!CaptureBuffer();
+    }
+
+    CaptureBuffer::!CaptureBuffer()
+    {
+        IntPtr captures = Interlocked::Exchange(_slot, IntPtr::Zero);
+        if(IntPtr::Zero != captures)
+            delete[] static_cast<StringPiece*>(captures.ToPointer());
+    }
+}
+}
@@ -0,0 +1,57 @@
+﻿/*
+ *  Re2.Net Copyright ©2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#pragma managed(push, off)
+    #include "re2\re2.h"
+#pragma managed(pop)
+
+
+namespace Re2
+{
+namespace Net
+{
+    using namespace System;
+
+    using re2::StringPiece;
+
+
+    /*
+     *  A scratch array of StringPieces for RE2's submatches, sized for every group of one Regex, which
+     *  searches rent and return rather than allocating their own. The array sits in a slot claimed with
+     *  Interlocked::Exchange(); a search that finds the slot empty, because another search is still using
+     *  the array, allocates one of its own, and whichever array comes back second is freed.
+     *
+     *  A single slot only saves allocations while one search at a time uses it, so there is one per
+     *  iteration rather than one per Regex alone. Regex::_nextMatch() hands the same buffer down a chain of
+     *  matches, so a Matches() or NextMatch() loop reuses one array for the groups of every match, and each
+     *  RegexScanner has its own. The Regex's own buffer serves the calls that search once, and any match
+     *  that isn't part of a chain. Interleaved iterations, and iterations on other threads, each have a
+     *  slot of their own; only concurrent use of one chain falls back to allocating.
+     */
+    private ref class CaptureBuffer sealed
+    {
+        private:
+
+            initonly int _count;
+            IntPtr       _slot;
+
+
+        internal:
+
+            CaptureBuffer(int count);
+
+            StringPiece* Rent();
+
+            void Return(StringPiece* captures);
+
+            ~CaptureBuffer();
+
+            !CaptureBuffer();
+    };
+}
+}
@@ -0,0 +1,77 @@
+﻿/*
+ *  Re2.Net Copyright ©2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#include "FileMapping.h"
+
+
+namespace Re2
+{
+namespace Net
+{
+    FileMapping::FileMapping()
+    {
+        _file   = nullptr;
+        _view   = nullptr;
+        _data   = nullptr;
+        _length = 0;
+    }
+
+    FileMapping^ FileMapping::Open(String^ path)
+    {
+        FileMapping^ rv     = gcnew FileMapping();
+        FileStream^  stream = gcnew FileStream(path, FileMode::Open, FileAccess::Read, FileShare::ReadWrite | FileShare::Delete);
+
+        try
+        {
+            rv->_length = stream->Length;
+            if(!rv->_length)
+            {
+                delete stream;
+                return rv;
+            }
+
+            /* leaveOpen is false, so the mapping closes the stream along with itself. */
+            rv->_file = MemoryMappedFile::CreateFromFile(stream, nullptr, 0, MemoryMappedFileAccess::Read, nullptr, HandleInheritability::None, false);
+        }
+        catch(Exception^)
+        {
+            delete stream;
+            throw;
+        }
+
+        try
+        {
+            Byte* data = nullptr;
+
+            rv->_view = rv->_file->CreateViewAccessor(0, 0, MemoryMappedFileAccess::Read);
+            rv->_view->SafeMemoryMappedViewHandle->AcquirePointer(data);
+
+            /* The view begins on an allocation boundary, which may lie before the offset asked for. */
+            rv->_data = data + rv->_view->PointerOffset;
+        }
+        catch(Exception^)
+        {
+            rv->Release();
+            throw;
+        }
+
+        return rv;
+    }
+
+    void FileMapping::Release()
+    {
+        /* Called at most once by RegexInputHandle, but also on the error paths of Regex, so it has to be idempotent. */
+        if(_data)
+            _view->SafeMemoryMappedViewHandle->ReleasePointer();
+
+        _data = nullptr;
+        delete _view;
+        delete _file;
+    }
+}
+}
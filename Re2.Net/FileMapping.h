@@ -0,0 +1,56 @@
+﻿/*
+ *  Re2.Net Copyright ©2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+
+namespace Re2
+{
+namespace Net
+{
+    using namespace System;
+    using namespace System::IO;
+    using namespace System::IO::MemoryMappedFiles;
+
+
+    /*
+     *  A read-only view of a whole file, which the IntPtr overloads of Regex search in place. Release() is
+     *  handed to them as the callback for the memory, so the view and the file are closed as soon as no
+     *  Match refers to them any more. The file is opened with FileShare::ReadWrite | FileShare::Delete so
+     *  that a log can go on being written while it's searched; bytes appended after the mapping is made
+     *  are not seen.
+     */
+    private ref class FileMapping sealed
+    {
+        private:
+
+            MemoryMappedFile^         _file;
+            MemoryMappedViewAccessor^ _view;
+            Byte*                     _data;
+            Int64                     _length;
+
+            FileMapping();
+
+
+        internal:
+
+            /* Maps path read-only. An empty file can't be mapped, so it's given a NULL Data of length 0. */
+            static FileMapping^ Open(String^ path);
+
+            property IntPtr Data
+            {
+                IntPtr get() { return IntPtr(_data); }
+            }
+
+            property Int64 Length
+            {
+                Int64 get() { return _length; }
+            }
+
+            void Release();
+    };
+}
+}
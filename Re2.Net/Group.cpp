@@ -16,7 +16,7 @@ namespace Re2
 {
 namespace Net
 {
-    Group::Group(RegexInput^ input, int index, int length)
+    Group::Group(RegexInput^ input, Int64 index, Int64 length)
         : Capture(input, index, length),
           _capcount(RegexInput::Empty == input ? 0 : 1)
     { }
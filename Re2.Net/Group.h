@@ -44,7 +44,7 @@ namespace Net
 
             static property Group^ Empty { Group^ get(); }
 
-            Group(RegexInput^ input, int index, int length);
+            Group(RegexInput^ input, Int64 index, Int64 length);
 
             
         public:
@@ -10,6 +10,7 @@
 #include "GroupCollection.h"
 #include "GroupEnumerator.h"
 #include "Match.h"
+#include "Regex.h"
 
 
 namespace Re2
@@ -18,12 +19,25 @@ namespace Net
 {
     GroupCollection::GroupCollection(Match^ match)
         : _match(match),
-          _groups(gcnew array<Group^>(match->_groupcount))
+          _offsets(nullptr),
+          _groups(nullptr)
     {
-        _groups[0] = _match;
+        /* Matches are found without their groups, which are only searched for now that they're wanted. */
+        if(_match->_regex && _match->_groupcount > 1)
+        {
+            _offsets = gcnew array<Int64>(2 * _match->_groupcount);
+            _match->_regex->_matchGroups(_match, _offsets);
+        }
     }
 
 
+    GroupCollection::GroupCollection(Match^ match, array<Int64>^ offsets)
+        : _match(match),
+          _offsets(offsets),
+          _groups(nullptr)
+    { }
+
+
     /*
      *  Regex::GroupNumberFromName() returns -1 if the name doesn't exist. GetGroup() therefore
      *  allows invalid values, and simply returns Group::Empty where normally we would expect an
@@ -31,8 +45,20 @@ namespace Net
      */
     Group^ GroupCollection::GetGroup(int groupNumber)
     {
-        if(groupNumber < 0 || groupNumber >= _groups->Length)
+        if(groupNumber < 0 || groupNumber >= _match->_groupcount)
             return Group::Empty;
+        if(!groupNumber)
+            return _match;
+
+        if(!_groups)
+            _groups = gcnew array<Group^>(_match->_groupcount);
+
+        if(!_groups[groupNumber])
+        {
+            Int64 index = _offsets[2*groupNumber];
+            _groups[groupNumber] = index < 0 ? Group::Empty : gcnew Group(_match->_input, index, _offsets[2*groupNumber + 1]);
+        }
+
         return _groups[groupNumber];
     }
 
@@ -61,12 +87,6 @@ namespace Net
     }
 
 
-    void GroupCollection::default::set(int groupNumber, Group^ group)
-    {
-        _groups[groupNumber] = group;
-    }
-
-
     Group^ GroupCollection::default::get(String^ groupName)
     {
         if(!_match->_regex)
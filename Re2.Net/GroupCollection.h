@@ -30,11 +30,19 @@ namespace Net
     {
         internal:
             
+            /*
+             *  _offsets holds an (index, length) pair for each group, with an index of -1 for groups that
+             *  didn't participate in the match. Group objects are only created, and cached in _groups, when
+             *  they are indexed, so a match whose groups are never read costs a single Int64 array.
+             */
+            array<Int64>^  _offsets;
             array<Group^>^ _groups;
             Match^         _match;
 
             GroupCollection(Match^ match);
 
+            GroupCollection(Match^ match, array<Int64>^ offsets);
+
             Group^ GetGroup(int groupNumber);
 
 
@@ -125,11 +133,7 @@ namespace Net
             /// <value>
             ///     The member of the collection specified by <paramref name="groupNumber"/>, or an empty <see cref="Group"/>.
             /// </value>
-            property Group^ default[int]
-            {
-                public:   Group^ get(int groupNumber);
-                internal: void   set(int groupNumber, Group^ group);
-            }
+            property Group^ default[int] { Group^ get(int groupNumber); }
     };
 }
 }
\ No newline at end of file
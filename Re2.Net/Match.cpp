@@ -17,13 +17,30 @@ namespace Re2
 {
 namespace Net
 {
-    Match::Match(Regex^ regex, int groupcount, RegexInput^ input, int begpos, int len, int nextpos)
+    Match::Match(Regex^ regex, int groupcount, RegexInput^ input, Int64 begpos, Int64 len, Int64 textpos, Int64 nextpos, RegexAnchor anchor)
         : Group(input, begpos, len)
     {
         _regex      = regex;
         _groupcount = groupcount;
         _input      = input;
+        _textpos    = textpos;
         _nextpos    = nextpos;
+        _anchor     = anchor;
+        _detached   = false;
+        _disposed   = false;
+
+        /* Match::Empty is never disposed, so it doesn't count as a reference. */
+        if(regex)
+            input->AddReference();
+    }
+
+    Match::~Match()
+    {
+        if(!_regex || _disposed)
+            return;
+
+        _disposed = true;
+        _input->Release();
     }
 
     Match^ Match::Empty::get()
@@ -43,20 +60,45 @@ namespace Net
     {
         if(!_regex)
             return this;
+        if(_detached)
+            return Match::Empty;
+        if(_disposed)
+            throw gcnew ObjectDisposedException("Match");
 
-        /* Explicitly advance the input start if the match is an empty string. */
-        int start = _length ? _nextpos : _nextpos + 1;
-        int end   = this->Input->Length;
+        return _regex->_nextMatch(this);
+    }
 
-        /* 
-         *  In .NET's Regex class matches are still attempted (and an empty match
-         *  can be successful) immediately after the last character of the input.
-         *  Thus start must be greater than end, and not simply equal to it.
-         */
-        if(start > end)
-            return Match::Empty;
+    Match^ Match::Detach()
+    {
+        if(!_regex || _detached)
+            return this;
+
+        /* The groups can only be found while the whole input is still at hand. */
+        GroupCollection^ groups = this->Groups;
+        RegexInput^      input;
+
+        if(_input->Bytes)
+        {
+            array<Byte>^ span = gcnew array<Byte>(this->Length);
+            Array::Copy(_input->Bytes, static_cast<int>(_index - _input->Origin), span, 0, span->Length);
+            input = gcnew RegexInput(span, _input->IsUTF8, _index);
+        }
+        else if(_input->IsByteInput)
+        {
+            array<Byte>^ span = gcnew array<Byte>(this->Length);
+            if(_length)
+                Marshal::Copy(IntPtr(const_cast<char*>(_input->Data) + _index), span, 0, span->Length);
+            input = gcnew RegexInput(span, _input->IsUTF8, _index);
+        }
+        else
+            input = gcnew RegexInput(this->Value, _input->IsUTF8, _index);
+
+        /* Group offsets never change once found, so the detached match can share them. */
+        Match^ rv      = gcnew Match(_regex, _groupcount, input, _index, _length, 0, 0, _anchor);
+        rv->_detached  = true;
+        rv->_groupcoll = gcnew GroupCollection(rv, groups->_offsets);
 
-        return _regex->_match(this->Input, start, end - start, _index + (_length ? _length : 1));
+        return rv;
     }
 
     //String^ Match::Result(String^ replacement)
@@ -6,9 +6,11 @@
 
 #pragma once
 
+#include "CaptureBuffer.h"
 #include "Group.h"
 #include "GroupCollection.h"
 #include "Regex.h"
+#include "RegexAnchor.h"
 #include "RegexInput.h"
 
 
@@ -23,6 +25,7 @@ namespace Net
 
     using re2::StringPiece;
 
+    ref class CaptureBuffer;
     ref class Group;
     ref class GroupCollection;
     ref class Regex;
@@ -36,15 +39,27 @@ namespace Net
     {
         internal:
             
-            static initonly Match^ _empty = gcnew Match(nullptr, 1, RegexInput::Empty, 0, 0, 0);
+            static initonly Match^ _empty = gcnew Match(nullptr, 1, RegexInput::Empty, 0, 0, 0, 0, RegexAnchor::None);
 
             Regex^           _regex;
             RegexInput^      _input;
+            CaptureBuffer^   _captures;
             GroupCollection^ _groupcoll;
             int              _groupcount;
-            int              _nextpos;
+            Int64            _textpos;
+            Int64            _nextpos;
+            RegexAnchor      _anchor;
+            bool             _detached;
+            bool             _disposed;
 
-            Match(Regex^ regex, int groupcount, RegexInput^ input, int begpos, int len, int nextpos);
+            /*
+             *  _textpos and _nextpos are the char offsets of the start and end of the match in the input
+             *  data. They bound the anchored search that fills in the groups when Groups is first read.
+             *  _anchor is kept so that NextMatch() searches the same way the first match was found.
+             *  _captures is the scratch array shared by a chain of matches found by NextMatch(), or
+             *  nullptr for a lone match, whose groups use the Regex's own.
+             */
+            Match(Regex^ regex, int groupcount, RegexInput^ input, Int64 begpos, Int64 len, Int64 textpos, Int64 nextpos, RegexAnchor anchor);
 
             /*
              *  With only one capture per group and no backtracking, RE2 doesn't need the many
@@ -76,9 +91,50 @@ namespace Net
             ///     which the last match ended (at the character after the last matched character).
             /// </summary>
             /// <returns>The next regular expression match.</returns>
+            /// <exception cref="System::ObjectDisposedException">
+            ///     The match has been disposed.
+            /// </exception>
             Match^ NextMatch();
 
 
+            /// <summary>
+            ///     Returns a copy of this <see cref="Match"/> that no longer refers to the input it was found in.
+            /// </summary>
+            /// <returns>
+            ///     A regular expression match with the same index, length, value and groups, which holds only the matched text.
+            /// </returns>
+            /// <remarks>
+            ///     <para>
+            ///         A <see cref="Match"/> keeps the whole input alive, including any converted copy of an input string and the
+            ///         pinning of an input byte array. A detached match holds only the matched text, so the input can be collected
+            ///         even while the match is kept.
+            ///     </para>
+            ///     <para>
+            ///         The groups are found before the match is detached. Index properties still refer to positions in the original
+            ///         input. Because the rest of the input is gone, <see cref="NextMatch"/> on a detached match always returns
+            ///         <see cref="Empty"/>.
+            ///     </para>
+            /// </remarks>
+            Match^ Detach();
+
+
+            /// <summary>
+            ///     Releases this match's hold on the native copy of an input string, or on the pinning of an input byte array.
+            /// </summary>
+            /// <remarks>
+            ///     <para>
+            ///         Every match found in the same input shares that input. Its native resources are released as soon as the last of
+            ///         those matches is disposed, rather than when the garbage collector finalizes them.
+            ///     </para>
+            ///     <para>
+            ///         The index, length, value and any groups that have already been read remain available after disposal.
+            ///         <see cref="NextMatch"/>, and reading <see cref="Groups"/> for the first time, require the input and throw
+            ///         <see cref="System::ObjectDisposedException"/> once it has been released.
+            ///     </para>
+            /// </remarks>
+            ~Match();
+
+
             ///// <summary>
             /////     Returns the expansion of the specified replacement pattern.
             ///// </summary>
@@ -22,7 +22,19 @@ namespace Net
         _matches = gcnew ArrayList();
         _done    = !match->Success;
         if(!_done)
+        {
             _matches->Add(_match);
+            _input = match->_input;
+            _input->AddReference();
+        }
+    }
+
+    void MatchCollection::_finish()
+    {
+        _done = true;
+        if(_input)
+            _input->Release();
+        _input = nullptr;
     }
 
     Match^ MatchCollection::GetMatch(int i)
@@ -38,10 +50,10 @@ namespace Net
 
         do
         {
-            _match = _match->NextMatch();
+            _match = _match->_regex->_nextMatch(_match);
             if(!_match->Success)
             {
-                _done = true;
+                this->_finish();
                 return nullptr;
             }
             _matches->Add(_match);
@@ -56,6 +68,25 @@ namespace Net
         _matches->CopyTo(array, arrayIndex);
     }
 
+    MatchCollection^ MatchCollection::Detach()
+    {
+        int count = this->Count;
+
+        /* An unsuccessful match yields a collection that is already done and empty. */
+        MatchCollection^ rv = gcnew MatchCollection(Match::Empty);
+        for(int i = 0; i < count; i++)
+            rv->_matches->Add(static_cast<Match^>(_matches[i])->Detach());
+
+        return rv;
+    }
+
+    MatchCollection::~MatchCollection()
+    {
+        this->_finish();
+        for(int i = 0; i < _matches->Count; i++)
+            delete static_cast<Match^>(_matches[i]);
+    }
+
     IEnumerator^ MatchCollection::GetEnumerator()
     {
         return gcnew MatchEnumerator(this);
@@ -18,6 +18,7 @@ namespace Net
 
     ref class Regex;
     ref class Match;
+    ref class RegexInput;
 
 
     /*
@@ -35,15 +36,25 @@ namespace Net
     {
         internal:
 
-            int        _done;
-            Match^     _match;
-            ArrayList^ _matches;
+            int         _done;
+            Match^      _match;
+            ArrayList^  _matches;
+            RegexInput^ _input;
+
+            /*
+             *  _input : The collection's own reference on the input, held until every match has been found.
+             *           Callers may dispose each match as they go, as in foreach(Match m in re.Matches(s))
+             *           using(m) ..., so the search for the next match can't rely on _match to keep the
+             *           input alive, and resumes from _match without going through Match::NextMatch().
+             */
         
 
         private:
 
             static int _infinite = 0x7fffffff;
 
+            void _finish();
+
 
         internal:
         
@@ -126,6 +137,28 @@ namespace Net
             ///     An object that can be used to synchronize access to the collection. This property always returns the object itself.
             /// </value>
             virtual property Object^ SyncRoot { Object^ get(); }
+
+
+            /// <summary>
+            ///     Finds all remaining matches and returns a collection of them that no longer refers to the input.
+            /// </summary>
+            /// <returns>A collection containing a detached copy of every match in this collection.</returns>
+            /// <remarks>
+            ///     Each match in the returned collection is created by <see cref="Match::Detach"/>. Only the matched text is kept,
+            ///     so the input can be collected while the results are kept.
+            /// </remarks>
+            MatchCollection^ Detach();
+
+
+            /// <summary>
+            ///     Disposes every match found so far, releasing the native resources held for the input.
+            /// </summary>
+            /// <remarks>
+            ///     No further matches are found after the collection is disposed. <see cref="Count"/> and the indexer report only the
+            ///     matches that had already been found. Until then the collection keeps the input alive itself, so each match can be
+            ///     disposed as soon as it has been used, even while the collection is still being enumerated.
+            /// </remarks>
+            ~MatchCollection();
     };
 }
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+﻿/*
+ *  Re2.Net Copyright ©2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#include "Match.h"
+#include "MatchStream.h"
+
+
+namespace Re2
+{
+namespace Net
+{
+    MatchStream::MatchStream(Match^ first)
+        : _first(first)
+    { }
+
+    IEnumerator<Match^>^ MatchStream::GetEnumerator()
+    {
+        return gcnew MatchStreamEnumerator(_first);
+    }
+
+    System::Collections::IEnumerator^ MatchStream::GetEnumeratorObject()
+    {
+        return this->GetEnumerator();
+    }
+
+
+    MatchStreamEnumerator::MatchStreamEnumerator(Match^ first)
+        : _first(first)
+    { }
+
+    bool MatchStreamEnumerator::MoveNext()
+    {
+        if(_done)
+            return false;
+        if(!_started && _first->_disposed)
+            throw gcnew InvalidOperationException("The first match has been disposed, so the matches cannot be enumerated again.");
+
+        _match   = _started ? _next : _first;
+        _next    = nullptr;
+        _started = true;
+        if(!_match->Success)
+        {
+            _done  = true;
+            _match = nullptr;
+            return false;
+        }
+
+        _next = _match->NextMatch();
+
+        return true;
+    }
+
+    void MatchStreamEnumerator::_release()
+    {
+        /* Only a match that was never handed out is the enumerator's to dispose. _first belongs to the MatchStream. */
+        if(_next && _next != _first)
+            delete _next;
+
+        _match = nullptr;
+        _next  = nullptr;
+    }
+
+    void MatchStreamEnumerator::Reset()
+    {
+        this->_release();
+
+        _started = false;
+        _done    = false;
+    }
+
+    Match^ MatchStreamEnumerator::Current::get()
+    {
+        if(!_match)
+            throw gcnew InvalidOperationException("EnumNotStarted");
+
+        return _match;
+    }
+
+    Object^ MatchStreamEnumerator::CurrentObject::get()
+    {
+        return this->Current;
+    }
+
+    MatchStreamEnumerator::~MatchStreamEnumerator()
+    {
+        this->_release();
+
+        _done = true;
+    }
+}
+}
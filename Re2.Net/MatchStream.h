@@ -0,0 +1,89 @@
+﻿/*
+ *  Re2.Net Copyright ©2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#include "Match.h"
+
+
+namespace Re2
+{
+namespace Net
+{
+    using namespace System;
+
+    using System::Collections::Generic::IEnumerable;
+    using System::Collections::Generic::IEnumerator;
+
+    ref class Match;
+
+
+    /*
+     *  MatchCollection keeps every Match it has found so that it can be indexed, which makes
+     *  a foreach over a large input hold every match at once. MatchStream is the sequence
+     *  returned by Regex::EnumerateMatches(): it keeps only the first match, and each of its
+     *  enumerators keeps only the current one and the one after it, so earlier matches can be
+     *  collected as soon as the caller lets go of them.
+     *
+     *  The enumerator finds the next match as soon as it hands out the current one, since the
+     *  caller may dispose the current match before asking for the next, and NextMatch() can't
+     *  be called on a disposed Match.
+     *
+     *  Every enumerator begins with _first. Once it has been disposed its input may be gone, so a
+     *  further enumeration throws InvalidOperationException rather than searching from it.
+     */
+    private ref class MatchStream sealed : public IEnumerable<Match^>
+    {
+        internal:
+
+            initonly Match^ _first;
+
+            MatchStream(Match^ first);
+
+
+        public:
+
+            virtual IEnumerator<Match^>^ GetEnumerator();
+
+
+        private:
+
+            virtual System::Collections::IEnumerator^ GetEnumeratorObject() sealed = System::Collections::IEnumerable::GetEnumerator;
+    };
+
+
+    private ref class MatchStreamEnumerator sealed : public IEnumerator<Match^>
+    {
+        internal:
+
+            initonly Match^ _first;
+            Match^          _match;
+            Match^          _next;
+            bool            _started;
+            bool            _done;
+
+            MatchStreamEnumerator(Match^ first);
+
+            void _release();
+
+
+        public:
+
+            virtual bool MoveNext();
+
+            virtual void Reset();
+
+            virtual property Match^ Current { Match^ get(); }
+
+            ~MatchStreamEnumerator();
+
+
+        private:
+
+            property Object^ CurrentObject { virtual Object^ get() sealed = System::Collections::IEnumerator::Current::get; }
+    };
+}
+}
@@ -10,16 +10,24 @@
     #include <stdlib.h>
     #include <malloc.h>
     #include <errno.h>
+    #include <string.h>
     #include <iostream>
     #include "re2\re2.h"
 #pragma managed(pop)
 
 #include <vcclr.h>
 #include "Regex.h"
+#include "BufferPool.h"
+#include "CaptureBuffer.h"
+#include "FileMapping.h"
+#include "RegexAnchor.h"
 #include "RegexOptions.h"
 #include "RegexInput.h"
 #include "Match.h"
 #include "MatchCollection.h"
+#include "MatchStream.h"
+#include "RegexScanner.h"
+#include "StreamSearch.h"
 
 
 namespace Re2
@@ -29,6 +37,7 @@ namespace Net
     using namespace System;
 
     using System::Collections::Generic::Dictionary;
+    using System::Collections::Generic::IEnumerable;
     using System::Collections::Generic::List;
     using System::Globalization::StringInfo;
     using System::Text::Encoding;
@@ -48,12 +57,14 @@ namespace Net
 
         #pragma managed(push, off)
 
-            static StringPiece* stringToUTF8(const wchar_t* chars, int length)
+            /*
+             *  Writes the UTF-8 encoding of chars to utf8, which must hold length * 3 bytes, and returns its size.
+             *  A surrogate in the last position has no partner, and is written as U+FFFD. Pairing it with a 0
+             *  would take 4 bytes for 1 char, overrunning the buffer by one, and be counted as 2 chars by
+             *  CharToStrPos().
+             */
+            static int stringToUTF8(const wchar_t* chars, int length, char* utf8)
             {
-                /* 2 bytes of UTF-16 can require up to 3 bytes of UTF-8. */
-                char* utf8 = static_cast<char*>(malloc(length * 3));
-                if(ENOMEM == errno) return nullptr;
-
                 int size = 0;
                 for(int i = 0; i < length; ++i)
                 {
@@ -62,6 +73,8 @@ namespace Net
 
                     if(!((unsigned)u <= 0xdfff - 0xd800))
                         c = chars[i];
+                    else if(i + 1 == length)
+                        c = 0xfffd;
                     else
                         c = u * 0x400 + chars[++i] + 0x2400;
 
@@ -91,60 +104,135 @@ namespace Net
                     #pragma warning(default:4244)
                 }
 
-                /* The memory block shouldn't need to be moved, but it's possible. */
-                utf8 = static_cast<char*>(realloc(utf8, size));
-                if(ENOMEM == errno) return nullptr;
+                return size;
+            }
+
+
+            /*
+             *  Narrows chars to single bytes, which covers both ASCII (max 0x7f) and Latin-1 (max 0xff).
+             *  Returns false at the first character above max.
+             */
+            static bool stringToSingleByte(const wchar_t* chars, int length, char* bytes, wchar_t max)
+            {
+                for(int i = 0; i < length; ++i)
+                {
+                    if(chars[i] > max)
+                        return false;
+
+                    bytes[i] = static_cast<char>(chars[i]);
+                }
 
-                return new StringPiece(utf8, size);
+                return true;
             }
 
-        #pragma managed(pop)
 
-        static StringPiece* StringToUTF8(String^ string)
-        {
-            pin_ptr<const wchar_t> chars = PtrToStringChars(string);
-            StringPiece* converted = stringToUTF8(chars, string->Length);
-            if(!converted) throw gcnew OutOfMemoryException();
-            return converted;
-        }
+            /*
+             *  Holds a transcoded String for the length of a call. Conversions that fit are made into inline
+             *  storage on the stack; longer ones are rented from BufferPool and returned by the destructor,
+             *  so the memory is given back as soon as matching finishes rather than whenever a finalizer runs.
+             */
+            class ConvertedString
+            {
+                public:
+
+                    ConvertedString()
+                        : _data(_inline), _length(0)
+                    { }
+
+                    ~ConvertedString()
+                    {
+                        if(_inline != _data)
+                            BufferPool::Return(_data);
+                    }
+
+                    /* Makes room for size bytes, returning NULL if memory is exhausted. */
+                    char* Reserve(int size)
+                    {
+                        if(size > InlineSize)
+                            _data = BufferPool::Rent(size);
+                        return _data;
+                    }
+
+                    void SetLength(int length)
+                    {
+                        _length = length;
+                    }
+
+                    StringPiece Piece() const
+                    {
+                        return StringPiece(_data, _length);
+                    }
+
+                    /*
+                     *  Hands the converted data over to the caller, who must pass it to BufferPool::Return().
+                     *  Inline data is first copied into a pooled block. Returns NULL if memory is exhausted.
+                     */
+                    char* Release()
+                    {
+                        char* rv = _data;
+                        if(_inline == _data)
+                        {
+                            rv = BufferPool::Rent(_length);
+                            if(rv)
+                                memcpy(rv, _inline, _length);
+                        }
+
+                        _data   = _inline;
+                        _length = 0;
+                        return rv;
+                    }
+
+
+                private:
+
+                    enum { InlineSize = 512 };
+
+                    char  _inline[InlineSize];
+                    char* _data;
+                    int   _length;
 
+                    ConvertedString(const ConvertedString&);
+                    ConvertedString& operator=(const ConvertedString&);
+            };
 
-        static StringPiece* StringToASCII(String^ string, String^ argument)
+        #pragma managed(pop)
+
+
+        /* Returns the most bytes that length chars can take in the encoding selected by options. */
+        static int MaxEncodedLength(int length, RegexOptions options)
         {
-            array<Byte>^ bytes = Encoding::ASCII->GetBytes(string);
-            if(string != Encoding::ASCII->GetString(bytes))
-                throw gcnew ArgumentOutOfRangeException(argument, "Specified argument was out of the range of valid ASCII values.");
-            pin_ptr<Byte> pinptr = &bytes[0];
-            char* copy = static_cast<char*>(malloc(bytes->Length));
-            if(ENOMEM == errno)
-                throw gcnew OutOfMemoryException();
-            memcpy(copy, pinptr, bytes->Length);
-            return new StringPiece(copy, bytes->Length);
+            /* 2 bytes of UTF-16 can require up to 3 bytes of UTF-8. */
+            return RegexOption::HasAnyFlag(options, RegexOptions::Latin1 | RegexOptions::ASCII) ? length : length * 3;
         }
 
 
         /*
-         *  The Latin-1 code page is available on systems with the full .NET Framework or the
-         *  .NET Framework Client Profile, but it may not be available on mobile or embedded
-         *  devices using the .NET Compact Framework.
+         *  Writes the encoding of chars selected by options to out, which must hold MaxEncodedLength() bytes,
+         *  and returns its size. Latin1 overrides ASCII if both are set.
          *
-         *  See: http://msdn.microsoft.com/en-us/library/x5b31f9d.aspx
+         *  Latin-1 is the first 256 code points of Unicode, so the conversion is a simple narrowing
+         *  and doesn't depend on the ISO-8859-1 code page being installed.
          */
-        static StringPiece* StringToLatin1(String^ string, String^ argument)
+        static int EncodeChars(const wchar_t* chars, int length, String^ argument, RegexOptions options, char* out)
         {
-            Encoding^    Latin1 = Encoding::GetEncoding("ISO-8859-1");
-            array<Byte>^ bytes  = Latin1->GetBytes(string);
-            if(string != Latin1->GetString(bytes))
+            if(RegexOption::HasAnyFlag(options, RegexOptions::Latin1))
             {
-                throw gcnew ArgumentOutOfRangeException(argument,
-                    "Specified argument was out of the range of valid Latin-1 values.");
+                if(!stringToSingleByte(chars, length, out, 0xff))
+                {
+                    throw gcnew ArgumentOutOfRangeException(argument,
+                        "Specified argument was out of the range of valid Latin-1 values.");
+                }
+                return length;
             }
-            pin_ptr<Byte> pinptr = &bytes[0];
-            char* copy = static_cast<char*>(malloc(bytes->Length));
-            if(ENOMEM == errno)
-                throw gcnew OutOfMemoryException();
-            memcpy(copy, pinptr, bytes->Length);
-            return new StringPiece(copy, bytes->Length);
+
+            if(RegexOption::HasAnyFlag(options, RegexOptions::ASCII))
+            {
+                if(!stringToSingleByte(chars, length, out, 0x7f))
+                    throw gcnew ArgumentOutOfRangeException(argument, "Specified argument was out of the range of valid ASCII values.");
+                return length;
+            }
+
+            return stringToUTF8(chars, length, out);
         }
 
 
@@ -159,17 +247,136 @@ namespace Net
         #pragma endregion
 
 
-        /* Call this function rather than the individual encoding functions. */
-        static StringPiece* ConvertStringEncoding(String^ string, String^ source, RegexOptions options)
+        /* Call these functions rather than the individual encoding functions. */
+        static void ConvertCharsEncoding(const wchar_t* chars, int length, String^ source, RegexOptions options, ConvertedString* converted)
         {
             /* I'd love to hear a good argument for why regex supports empty patterns and inputs. */
-            if(!string->Length)
-                return new StringPiece(static_cast<char*>(malloc(0)), 0);
+            if(!length)
+                return;
+
+            char* out = converted->Reserve(MaxEncodedLength(length, options));
+            if(!out)
+                throw gcnew OutOfMemoryException();
+
+            converted->SetLength(EncodeChars(chars, length, source, options, out));
+        }
+
+
+        static void ConvertStringEncoding(String^ string, String^ source, RegexOptions options, ConvertedString* converted)
+        {
+            pin_ptr<const wchar_t> chars = PtrToStringChars(string);
+            ConvertCharsEncoding(chars, string->Length, source, options, converted);
+        }
+
+
+        static void ConvertCharsEncoding(ArraySegment<Char> chars, String^ source, RegexOptions options, ConvertedString* converted)
+        {
+            pin_ptr<Char> pinned = chars.Count ? &chars.Array[chars.Offset] : nullptr;
+            ConvertCharsEncoding(pinned, chars.Count, source, options, converted);
+        }
 
-            /* Latin1 overrides ASCII if both are set. */
-            return RegexOption::HasAnyFlag(options, RegexOptions::Latin1) ? StringToLatin1(string, source) :
-                   RegexOption::HasAnyFlag(options, RegexOptions::ASCII)  ? StringToASCII(string, source)  :
-                                                                            StringToUTF8(string);
+
+        /*
+         *  .NET Framework offers no way to read a StringBuilder's chunks in place, so the builder is copied out a
+         *  block at a time into a small buffer and each block is transcoded from there, rather than making a String
+         *  of the whole builder first. A block never ends on a surrogate that takes its partner from the next block:
+         *  stringToUTF8() pairs surrogates off from the start of each run, so the last one of an odd run is held back.
+         */
+        static void ConvertBuilderEncoding(StringBuilder^ builder, String^ source, RegexOptions options, ConvertedString* converted)
+        {
+            int length = builder->Length;
+            if(!length)
+                return;
+
+            char* out = converted->Reserve(MaxEncodedLength(length, options));
+            if(!out)
+                throw gcnew OutOfMemoryException();
+
+            array<Char>^  block    = gcnew array<Char>(length < 4096 ? length : 4096);
+            pin_ptr<Char> chars    = &block[0];
+            bool          isUtf8   = !RegexOption::HasAnyFlag(options, RegexOptions::Latin1 | RegexOptions::ASCII);
+            int           position = 0;
+            int           size     = 0;
+
+            while(position < length)
+            {
+                int count = length - position < block->Length ? length - position : block->Length;
+                builder->CopyTo(position, block, 0, count);
+
+                if(isUtf8 && position + count < length)
+                {
+                    int run = 0;
+                    while(run < count && static_cast<unsigned>(chars[count - 1 - run] - 0xd800) <= 0xdfff - 0xd800)
+                        ++run;
+                    if(run & 1)
+                        --count;
+                }
+
+                size     += EncodeChars(chars, count, source, options, out + size);
+                position += count;
+            }
+
+            converted->SetLength(size);
+        }
+
+
+        /* Hands converted data over to a RegexInput, which takes ownership of the pooled block. */
+        static char* ReleaseConverted(ConvertedString* converted, int* length)
+        {
+            *length = static_cast<int>(converted->Piece().length());
+
+            char* data = converted->Release();
+            if(!data)
+                throw gcnew OutOfMemoryException();
+
+            return data;
+        }
+
+
+        /* Converts a String for a RegexInput, which takes ownership of the pooled data. */
+        static RegexInput^ CreateRegexInput(String^ string, String^ source, RegexOptions options, bool isUtf8)
+        {
+            ConvertedString converted;
+            ConvertStringEncoding(string, source, options, &converted);
+
+            int   length;
+            char* data = ReleaseConverted(&converted, &length);
+
+            return gcnew RegexInput(string, data, length, isUtf8);
+        }
+
+
+        static RegexInput^ CreateRegexInput(ArraySegment<Char> chars, String^ source, RegexOptions options, bool isUtf8)
+        {
+            ConvertedString converted;
+            ConvertCharsEncoding(chars, source, options, &converted);
+
+            int   length;
+            char* data = ReleaseConverted(&converted, &length);
+
+            return gcnew RegexInput(chars, data, length, isUtf8);
+        }
+
+
+        static RegexInput^ CreateRegexInput(StringBuilder^ builder, String^ source, RegexOptions options, bool isUtf8)
+        {
+            ConvertedString converted;
+            ConvertBuilderEncoding(builder, source, options, &converted);
+
+            int   length;
+            char* data = ReleaseConverted(&converted, &length);
+
+            return gcnew RegexInput(builder, data, length, isUtf8);
+        }
+
+
+        /* Validates a block of caller memory passed in place of a byte array. */
+        static void CheckNativeInput(IntPtr data, Int64 length)
+        {
+            if(length < 0 || (4 == IntPtr::Size && length > UInt32::MaxValue))
+                throw gcnew ArgumentOutOfRangeException("length", "Length cannot be less than 0 or greater than the address space.");
+            if(IntPtr::Zero == data && length)
+                throw gcnew ArgumentNullException("data", "Value cannot be null.");
         }
 
     #pragma endregion
@@ -260,6 +467,308 @@ namespace Net
             return rv;
         }
 
+
+        /*
+         *  Writes an (index, length) pair for each of count captures, translating char offsets into String
+         *  indices for UTF-8 String input. Groups lie within the match, so their indices are counted on from
+         *  the match's index rather than from startIndex. Groups that didn't participate are given index -1.
+         *
+         *  T is int for the offsets arrays of the public API, and long long for the groups of a Match, which
+         *  may lie beyond 2 GB in native memory. UTF-8 translation only applies to Strings, which never do.
+         */
+        template<typename T>
+        static void CapturesToOffsets(const char* data, const StringPiece* captures, int count,
+                                      T startIndex, T strStartIndex, bool isUtf8, T* offsets)
+        {
+            const char* match  = captures[0].data();
+            T           length = static_cast<T>(captures[0].length());
+            T           offset = static_cast<T>(match - data);
+
+            offsets[0] = isUtf8 ? CharToStrPos(data + startIndex, static_cast<int>(offset - startIndex)) + strStartIndex : offset;
+            offsets[1] = isUtf8 ? CharToStrPos(match, static_cast<int>(length)) : length;
+
+            for(int i = 1; i < count; i++)
+            {
+                if(NULL == captures[i].data())
+                {
+                    offsets[2*i]     = -1;
+                    offsets[2*i + 1] = 0;
+                    continue;
+                }
+
+                offset = static_cast<T>(captures[i].data() - data);
+                length = static_cast<T>(captures[i].length());
+
+                offsets[2*i]     = isUtf8 ? CharToStrPos(match, static_cast<int>(captures[i].data() - match)) + offsets[0] : offset;
+                offsets[2*i + 1] = isUtf8 ? CharToStrPos(captures[i].data(), static_cast<int>(length)) : length;
+            }
+        }
+
+
+        /* Returns the length of the UTF-8 sequence led by c, treating stray continuation bytes as length 1. */
+        static int UTF8SequenceLength(char c)
+        {
+            unsigned char lead = static_cast<unsigned char>(c);
+            return lead < 0xc0 ? 1 :
+                   lead < 0xe0 ? 2 :
+                   lead < 0xf0 ? 3 :
+                                 4;
+        }
+
+
+        /*
+         *  Steps the search position past an empty match. For UTF-8 String input the step is a whole UTF-8
+         *  sequence, so the search never resumes inside a character, and the String index moves on by two
+         *  UTF-16 code units when that character lies outside the BMP.
+         */
+        template<typename T>
+        static void StepOverEmptyMatch(const char* data, T length, bool isUtf8, T* charpos, T* strpos)
+        {
+            int step = 1;
+            if(isUtf8 && *charpos < length)
+            {
+                step = UTF8SequenceLength(data[*charpos]);
+                if(step > length - *charpos)
+                    step = length - *charpos;
+            }
+
+            *charpos += step;
+            *strpos  += 4 == step ? 2 : 1;
+        }
+
+
+        /*
+         *  A Multiline pattern that begins with '^' can only match at the start of a line. For such patterns
+         *  the Regex holds a LineAnchor, and searches skip from one line start to the next with memchr().
+         *  prefix holds any literal text that must follow the '^', so that most lines are turned down by
+         *  memcmp() without calling into RE2 at all. RE2 is only called once, from the first line start that
+         *  passes: a search anchored at each line start in turn would rescan the text after it once per line
+         *  whenever the pattern can match across a newline, where one unanchored search reads it once.
+         */
+        struct LineAnchor
+        {
+            char* prefix;
+            int   length;
+        };
+
+
+        static bool SearchLineStarts(const RE2* re, const LineAnchor* lines, const StringPiece& text, long long startpos, long long endpos,
+                                     StringPiece* submatch, int nsubmatch)
+        {
+            const char* data = text.data();
+            long long   pos  = startpos;
+
+            while(pos <= endpos)
+            {
+                if(pos > 0 && '\n' != data[pos - 1])
+                {
+                    const char* newline = static_cast<const char*>(memchr(data + pos, '\n', static_cast<size_t>(endpos - pos)));
+                    if(!newline)
+                        return false;
+
+                    pos = newline - data + 1;
+                }
+
+                /* Every match begins at a line start, so the leftmost one from here is the match at the first line start that has one. */
+                if(!lines->length || (endpos - pos >= lines->length && !memcmp(data + pos, lines->prefix, lines->length)))
+                    return re->Match(text, static_cast<size_t>(pos), static_cast<size_t>(endpos), RE2::UNANCHORED, submatch, nsubmatch);
+
+                /* If the line was empty, pos is now itself a line start; otherwise memchr() finds the next one. */
+                ++pos;
+            }
+
+            return false;
+        }
+
+
+        /* Runs a search with RE2, confining unanchored searches to line starts where the pattern allows. */
+        static bool Search(const RE2* re, const LineAnchor* lines, const StringPiece& text, long long startpos, long long endpos,
+                           RE2::Anchor anchor, StringPiece* submatch, int nsubmatch)
+        {
+            if(lines && RE2::UNANCHORED == anchor)
+                return SearchLineStarts(re, lines, text, startpos, endpos, submatch, nsubmatch);
+
+            return re->Match(text, static_cast<size_t>(startpos), static_cast<size_t>(endpos), anchor, submatch, nsubmatch);
+        }
+
+
+        /*
+         *  Runs the find-all loop of Matches() without leaving native code, writing groupCount (index, length)
+         *  pairs per match into offsets until either the input runs out or capacity matches have been written.
+         *  On return, charpos and strpos hold the position at which to resume, or charpos is past the end of
+         *  the text if no more matches can be found.
+         */
+        static int FindAll(const RE2* re, const LineAnchor* lines, const StringPiece& text, bool isUtf8, StringPiece* captures, int groupCount,
+                           int* offsets, int capacity, int* charpos, int* strpos)
+        {
+            int end   = static_cast<int>(text.length());
+            int count = 0;
+
+            while(count < capacity && *charpos <= end)
+            {
+                if(!Search(re, lines, text, *charpos, end, RE2::UNANCHORED, captures, groupCount))
+                {
+                    *charpos = end + 1;
+                    break;
+                }
+
+                int* pairs = offsets + 2 * groupCount * count++;
+                CapturesToOffsets(text.data(), captures, groupCount, *charpos, *strpos, isUtf8, pairs);
+
+                *charpos = static_cast<int>(captures[0].data() - text.data() + captures[0].length());
+                *strpos  = pairs[0] + pairs[1];
+
+                if(!captures[0].length())
+                    StepOverEmptyMatch(text.data(), end, isUtf8, charpos, strpos);
+            }
+
+            return count;
+        }
+
+
+        /*
+         *  Counts the matches FindAll would find between charpos and end, tracking only the bounds of the
+         *  overall match.
+         */
+        static int CountAll(const RE2* re, const LineAnchor* lines, const StringPiece& text, int charpos, int end, bool isUtf8)
+        {
+            StringPiece match;
+            int         strpos = 0;
+            int         count  = 0;
+
+            while(charpos <= end && Search(re, lines, text, charpos, end, RE2::UNANCHORED, &match, 1))
+            {
+                count++;
+                charpos = static_cast<int>(match.data() - text.data() + match.length());
+
+                if(!match.length())
+                    StepOverEmptyMatch(text.data(), end, isUtf8, &charpos, &strpos);
+            }
+
+            return count;
+        }
+
+
+        /*
+         *  Runs the line mode of MatchLines() and CountLines() without leaving native code. memchr(), which the CRT
+         *  vectorizes, finds each '\n', and each line is searched as a text of its own, without its terminator,
+         *  so that '^' and '$' anchor at its ends. The DFAs answer each line on their own, since no submatches
+         *  are asked for, and a LineAnchor turns lines down with memcmp() before RE2 sees them at all.
+         *
+         *  For each line that matches (or, with invert, that doesn't) a (line number, index, length) triple is
+         *  written to out, until capacity lines have been found; out may be NULL to count them only. Line numbers
+         *  start at 1, as grep's do. A final '\n' doesn't begin another line. For UTF-8 String input the indices
+         *  are translated into String indices, carrying the translation forward from one reported line to the next
+         *  rather than from the start of the text.
+         */
+        static int MatchLinesIn(const RE2* re, const LineAnchor* lines, const StringPiece& text, bool isUtf8, bool invert,
+                                int* out, int capacity)
+        {
+            const char* data    = text.data();
+            int         end     = static_cast<int>(text.length());
+            int         start   = 0;
+            int         number  = 0;
+            int         count   = 0;
+            int         charpos = 0;
+            int         strpos  = 0;
+
+            while(start < end && count < capacity)
+            {
+                const char* newline = static_cast<const char*>(memchr(data + start, '\n', end - start));
+                int         length  = newline ? static_cast<int>(newline - data) - start : end - start;
+                StringPiece line(data + start, length);
+
+                ++number;
+
+                bool matched = (!lines || (length >= lines->length && !memcmp(line.data(), lines->prefix, lines->length)))
+                               && re->Match(line, 0, length, RE2::UNANCHORED, NULL, 0);
+
+                if(matched != invert)
+                {
+                    if(out)
+                    {
+                        if(isUtf8)
+                        {
+                            strpos  += CharToStrPos(data + charpos, start - charpos);
+                            charpos  = start;
+                        }
+
+                        out[3*count]     = number;
+                        out[3*count + 1] = isUtf8 ? strpos : start;
+                        out[3*count + 2] = isUtf8 ? CharToStrPos(line.data(), length) : length;
+                    }
+
+                    ++count;
+                }
+
+                start += length + 1;
+            }
+
+            return count;
+        }
+
+
+        /*
+         *  Finds the match that begins at the last position where any match begins. RE2 keeps its reverse
+         *  program private, so the position is found with forward searches instead. Whether a match begins
+         *  at or after a position only becomes false as the position moves on, so it can be binary searched.
+         *  Each test is a search without submatches, which RE2's DFA answers on its own, stopping at the first
+         *  match. The bounds come from windows at the end of the text that double in size until a match begins
+         *  inside one, so the cost depends on how far the match is from the end. Text after the position is
+         *  still passed as context, so '$' and '\b' behave as in a forward search.
+         *
+         *  This is not always the last match that Matches() finds. A forward walk resumes at the end of each
+         *  match, and where matches abut, which of them it finds depends on every match before them.
+         */
+        static bool FindLast(const RE2* re, const StringPiece& text, bool isUtf8, StringPiece* match)
+        {
+            long long end    = static_cast<long long>(text.length());
+            long long window = 256;
+            long long lo;
+
+            /* No match begins at or after hi. */
+            long long hi = end + 1;
+
+            for(;;)
+            {
+                lo = end - window > 0 ? end - window : 0;
+
+                /* Never begin a search inside a UTF-8 sequence. */
+                if(isUtf8)
+                    while(lo > 0 && (text[lo] & 0xc0) == 0x80)
+                        --lo;
+
+                if(re->Match(text, static_cast<size_t>(lo), static_cast<size_t>(end), RE2::UNANCHORED, NULL, 0))
+                    break;
+                if(!lo)
+                    return false;
+
+                hi      = lo;
+                window *= 2;
+            }
+
+            /* A match begins at or after lo. Narrow [lo, hi) until no position between them is left to test. */
+            for(;;)
+            {
+                long long mid = lo + (hi - lo) / 2;
+
+                if(isUtf8)
+                    while(mid > lo && mid < end && (text[mid] & 0xc0) == 0x80)
+                        --mid;
+                if(mid == lo)
+                    mid = lo + (isUtf8 && lo < end ? UTF8SequenceLength(text[lo]) : 1);
+                if(mid >= hi)
+                    break;
+
+                if(re->Match(text, static_cast<size_t>(mid), static_cast<size_t>(end), RE2::UNANCHORED, NULL, 0))
+                    lo = mid;
+                else
+                    hi = mid;
+            }
+
+            return re->Match(text, static_cast<size_t>(lo), static_cast<size_t>(end), RE2::UNANCHORED, match, 1);
+        }
+
         #pragma managed(pop)
 
     #pragma endregion
@@ -355,6 +864,20 @@ namespace Net
         }
 
 
+        int Regex::ByteCopyThreshold::get()
+        {
+            return Regex::_byteCopyThreshold;
+        }
+
+
+        void Regex::ByteCopyThreshold::set(int value)
+        {
+            if(value < 0)
+                throw gcnew ArgumentOutOfRangeException("value");
+            Regex::_byteCopyThreshold = value;
+        }
+
+
         String^ Regex::ToString()
         {
             return this->Pattern;
@@ -366,17 +889,31 @@ namespace Net
             if(!name)
                 throw gcnew ArgumentNullException("name");
 
-            map<string, int> map = _re2->NamedCapturingGroups();
-            StringPiece*     sp  = ConvertStringEncoding(name, "name", this->Options);
+            int rv;
+            return _groupNumbers->TryGetValue(name, rv) ? rv : -1;
+        }
 
-            int    rv  = -1;
-            string str = sp->ToString(); 
 
-            if(map.count(str))
-                rv = map[str];
+        String^ Regex::GroupNameFromNumber(int i)
+        {
+            if(i < 0 || i >= _groupNames->Length)
+                return String::Empty;
 
-            free(const_cast<char*>(sp->data()));
-            delete sp;
+            return _groupNames[i];
+        }
+
+
+        array<String^>^ Regex::GetGroupNames()
+        {
+            return safe_cast<array<String^>^>(_groupNames->Clone());
+        }
+
+
+        array<int>^ Regex::GetGroupNumbers()
+        {
+            array<int>^ rv = gcnew array<int>(_groupNames->Length);
+            for(int i = 0; i < rv->Length; i++)
+                rv[i] = i;
 
             return rv;
         }
@@ -395,13 +932,11 @@ namespace Net
             if(startIndex < 0 || startIndex > input->Length)
                 throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
 
-            StringPiece* sp = ConvertStringEncoding(input, "input", this->Options);
-            bool         rv = _re2->Match(*sp, startIndex, sp->length(), RE2::UNANCHORED, NULL, 0);
-            
-            free(const_cast<char*>(sp->data()));
-            delete sp;
-            
-            return rv;
+            ConvertedString converted;
+            ConvertStringEncoding(input, "input", this->Options, &converted);
+
+            StringPiece sp = converted.Piece();
+            return _re2->Match(sp, startIndex, sp.length(), RE2::UNANCHORED, NULL, 0);
         }
 
 
@@ -434,124 +969,954 @@ namespace Net
         }
 
 
-        bool Regex::IsMatch(String^ input, String^ pattern, RegexOptions options)
+        bool Regex::IsMatch(IntPtr data, Int64 length)
         {
-            return Cache::FindOrCreate(pattern, options)->IsMatch(input);
-        }
+            CheckNativeInput(data, length);
 
-
-        bool Regex::IsMatch(array<Byte>^ input, String^ pattern, RegexOptions options)
-        {
-            return Cache::FindOrCreate(pattern, options)->IsMatch(input);
+            StringPiece sp(static_cast<const char*>(data.ToPointer()), static_cast<size_t>(length));
+            return _re2->Match(sp, 0, sp.length(), RE2::UNANCHORED, NULL, 0);
+        }
+
+
+        bool Regex::IsMatch(array<Char>^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            return this->IsMatch(ArraySegment<Char>(input));
+        }
+
+
+        bool Regex::IsMatch(ArraySegment<Char> input)
+        {
+            if(!input.Array)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            ConvertedString converted;
+            ConvertCharsEncoding(input, "input", this->Options, &converted);
+
+            StringPiece sp = converted.Piece();
+            return _re2->Match(sp, 0, sp.length(), RE2::UNANCHORED, NULL, 0);
+        }
+
+
+        bool Regex::IsMatch(StringBuilder^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            ConvertedString converted;
+            ConvertBuilderEncoding(input, "input", this->Options, &converted);
+
+            StringPiece sp = converted.Piece();
+            return _re2->Match(sp, 0, sp.length(), RE2::UNANCHORED, NULL, 0);
+        }
+
+
+        bool Regex::IsMatchInFile(String^ path)
+        {
+            if(!path)
+                throw gcnew ArgumentNullException("path", "Value cannot be null.");
+
+            FileMapping^ mapping = FileMapping::Open(path);
+            try
+            {
+                return this->IsMatch(mapping->Data, mapping->Length);
+            }
+            finally
+            {
+                mapping->Release();
+            }
+        }
+
+
+        bool Regex::IsMatch(String^ input, String^ pattern, RegexOptions options)
+        {
+            return Cache::FindOrCreate(pattern, options)->IsMatch(input);
+        }
+
+
+        bool Regex::IsMatch(array<Byte>^ input, String^ pattern, RegexOptions options)
+        {
+            return Cache::FindOrCreate(pattern, options)->IsMatch(input);
         }
 
 
         bool Regex::IsMatch(String^ input, String^ pattern)
         {
-            return Cache::FindOrCreate(pattern, RegexOptions::None)->IsMatch(input);
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->IsMatch(input);
+        }
+
+
+        bool Regex::IsMatch(array<Byte>^ input, String^ pattern)
+        {
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->IsMatch(input);
+        }
+
+
+        bool Regex::IsFullMatch(String^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            ConvertedString converted;
+            ConvertStringEncoding(input, "input", this->Options, &converted);
+
+            StringPiece sp = converted.Piece();
+            return _re2->Match(sp, 0, sp.length(), RE2::ANCHOR_BOTH, NULL, 0);
+        }
+
+
+        bool Regex::IsFullMatch(array<Byte>^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            pin_ptr<Byte> bytes = input->Length ? &input[0] : nullptr;
+            StringPiece   sp((const char*)bytes, input->Length);
+
+            return _re2->Match(sp, 0, sp.length(), RE2::ANCHOR_BOTH, NULL, 0);
+        }
+
+
+        bool Regex::IsFullMatch(String^ input, String^ pattern, RegexOptions options)
+        {
+            return Cache::FindOrCreate(pattern, options)->IsFullMatch(input);
+        }
+
+
+        bool Regex::IsFullMatch(array<Byte>^ input, String^ pattern, RegexOptions options)
+        {
+            return Cache::FindOrCreate(pattern, options)->IsFullMatch(input);
+        }
+
+
+        bool Regex::IsFullMatch(String^ input, String^ pattern)
+        {
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->IsFullMatch(input);
+        }
+
+
+        bool Regex::IsFullMatch(array<Byte>^ input, String^ pattern)
+        {
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->IsFullMatch(input);
+        }
+
+        #pragma endregion
+
+
+        #pragma region TryMatch
+
+        bool Regex::_tryMatch(const StringPiece& haystack, int startIndex, int strStartIndex, bool isUtf8, array<int>^ offsets)
+        {
+            int groupCount = RegexOption::HasAnyFlag(this->Options, RegexOptions::SingleCapture) ? 1 : 1 + _re2->NumberOfCapturingGroups();
+            if(groupCount > offsets->Length / 2)
+                groupCount = offsets->Length / 2;
+
+            /* A lone match is the common case, and needs no scratch array. */
+            StringPiece  match;
+            StringPiece* captures = groupCount > 1 ? _captures->Rent() : &match;
+
+            bool rv = Search(_re2, _lineAnchor, haystack, startIndex, static_cast<int>(haystack.length()), RE2::UNANCHORED, captures, groupCount);
+            if(rv)
+            {
+                pin_ptr<int> pinned = &offsets[0];
+                CapturesToOffsets<int>(haystack.data(), captures, groupCount, startIndex, strStartIndex, isUtf8, pinned);
+            }
+
+            if(captures != &match)
+                _captures->Return(captures);
+
+            return rv;
+        }
+
+
+        bool Regex::TryMatch(String^ input, int startIndex, array<int>^ offsets)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(!offsets)
+                throw gcnew ArgumentNullException("offsets", "Value cannot be null.");
+            if(startIndex < 0 || startIndex > input->Length)
+                throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
+            if(offsets->Length < 2)
+                throw gcnew ArgumentException("Offsets must have room for at least one index and length pair.", "offsets");
+            if(startIndex > 0 && startIndex < input->Length && Char::IsLowSurrogate(input, startIndex))
+                throw gcnew ArgumentException("Start index cannot bisect a UTF-16 surrogate pair.", "startIndex");
+
+            ConvertedString converted;
+            ConvertStringEncoding(input, "input", this->Options, &converted);
+
+            bool        isUtf8 = !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING);
+            StringPiece sp     = converted.Piece();
+            int         start  = isUtf8 && startIndex ? StrToCharPos(sp.data(), startIndex) : startIndex;
+
+            return this->_tryMatch(sp, start, startIndex, isUtf8, offsets);
+        }
+
+
+        bool Regex::TryMatch(array<Byte>^ input, int startIndex, array<int>^ offsets)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(!offsets)
+                throw gcnew ArgumentNullException("offsets", "Value cannot be null.");
+            if(startIndex < 0 || startIndex > input->Length)
+                throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
+            if(offsets->Length < 2)
+                throw gcnew ArgumentException("Offsets must have room for at least one index and length pair.", "offsets");
+
+            /* An empty array has no first element to pin. */
+            pin_ptr<Byte> bytes = input->Length ? &input[0] : nullptr;
+            StringPiece   sp((const char*)bytes, input->Length);
+
+            /* Byte indices need no translation, regardless of encoding. */
+            return this->_tryMatch(sp, startIndex, startIndex, false, offsets);
+        }
+
+        #pragma endregion
+
+
+        #pragma region MatchOffsets
+
+        int Regex::_matchOffsets(const StringPiece& haystack, int startIndex, int strStartIndex, bool isUtf8, array<int>^ offsets, int% nextIndex)
+        {
+            int groupCount = RegexOption::HasAnyFlag(this->Options, RegexOptions::SingleCapture) ? 1 : 1 + _re2->NumberOfCapturingGroups();
+            int capacity   = offsets->Length / (2 * groupCount);
+            if(!capacity)
+                throw gcnew ArgumentException("Offsets must have room for the index and length of a match and all of its groups.", "offsets");
+
+            StringPiece  match;
+            StringPiece* captures = groupCount > 1 ? _captures->Rent() : &match;
+            pin_ptr<int> pinned   = &offsets[0];
+
+            int charpos = startIndex;
+            int strpos  = strStartIndex;
+            int rv      = FindAll(_re2, _lineAnchor, haystack, isUtf8, captures, groupCount, pinned, capacity, &charpos, &strpos);
+
+            if(captures != &match)
+                _captures->Return(captures);
+
+            nextIndex = charpos > static_cast<int>(haystack.length()) ? -1 : strpos;
+            return rv;
+        }
+
+
+        int Regex::MatchOffsets(String^ input, int startIndex, array<int>^ offsets, int% nextIndex)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(!offsets)
+                throw gcnew ArgumentNullException("offsets", "Value cannot be null.");
+            if(startIndex < 0 || startIndex > input->Length)
+                throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
+            if(startIndex > 0 && startIndex < input->Length && Char::IsLowSurrogate(input, startIndex))
+                throw gcnew ArgumentException("Start index cannot bisect a UTF-16 surrogate pair.", "startIndex");
+
+            ConvertedString converted;
+            ConvertStringEncoding(input, "input", this->Options, &converted);
+
+            bool        isUtf8 = !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING);
+            StringPiece sp     = converted.Piece();
+            int         start  = isUtf8 && startIndex ? StrToCharPos(sp.data(), startIndex) : startIndex;
+
+            return this->_matchOffsets(sp, start, startIndex, isUtf8, offsets, nextIndex);
+        }
+
+
+        int Regex::MatchOffsets(array<Byte>^ input, int startIndex, array<int>^ offsets, int% nextIndex)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(!offsets)
+                throw gcnew ArgumentNullException("offsets", "Value cannot be null.");
+            if(startIndex < 0 || startIndex > input->Length)
+                throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
+
+            pin_ptr<Byte> bytes = input->Length ? &input[0] : nullptr;
+            StringPiece   sp((const char*)bytes, input->Length);
+
+            return this->_matchOffsets(sp, startIndex, startIndex, false, offsets, nextIndex);
+        }
+
+
+        int Regex::MatchOffsets(String^ input, array<int>^ offsets)
+        {
+            int nextIndex;
+            return this->MatchOffsets(input, 0, offsets, nextIndex);
+        }
+
+
+        int Regex::MatchOffsets(array<Byte>^ input, array<int>^ offsets)
+        {
+            int nextIndex;
+            return this->MatchOffsets(input, 0, offsets, nextIndex);
+        }
+
+        #pragma endregion
+
+
+        #pragma region Match
+
+        CaptureBuffer^ Regex::_newCaptureBuffer()
+        {
+            /* Sized for every group, so the same array serves SingleCapture and full captures alike. */
+            return gcnew CaptureBuffer(1 + _re2->NumberOfCapturingGroups());
+        }
+
+
+        _Match^ Regex::_match(RegexInput^ input, Int64 startIndex, Int64 length, Int64 strStartIndex, RegexAnchor anchor)
+        {
+            /*
+             *  stringStartIndex tracks inputIndex for String inputs between matches to avoid recalculating
+             *  in CharToStrPos(), which is prohibitively costly for large inputs.
+             *
+             *  Only the bounds of the match are requested here, which lets RE2 answer with its DFAs alone.
+             *  The groups are filled in by _matchGroups() if and when Match::Groups is first accessed.
+             *
+             *  RegexAnchor shares its values with RE2::Anchor.
+             *
+             *  Byte arrays above ByteCopyThreshold are pinned only for the duration of the search, here and
+             *  wherever else an input is searched.
+             */
+
+            int           groupCount = RegexOption::HasAnyFlag(this->Options, RegexOptions::SingleCapture) ? 1 : 1 + _re2->NumberOfCapturingGroups();
+            pin_ptr<Byte> pinned     = input->PinPerCall && input->Length ? &input->Bytes[0] : nullptr;
+            StringPiece   match;
+            StringPiece   haystack(input->PinPerCall ? (const char*)pinned : input->Data, static_cast<size_t>(input->Length));
+
+            if(!Search(_re2, _lineAnchor, haystack, startIndex, startIndex + length, static_cast<RE2::Anchor>(anchor), &match, 1))
+                return _Match::Empty;
+
+            /* Ignore the encoding of input byte arrays. */
+            bool  isUtf8     = input->IsByteInput ? false : input->IsUTF8;
+            Int64 charOffset = match.data() - haystack.data();
+            Int64 inputIndex = isUtf8 && charOffset ? CharToStrPos(haystack.data() + startIndex, static_cast<int>(charOffset - startIndex)) + strStartIndex : charOffset;
+            Int64 capLength  = isUtf8 ? CharToStrPos(match.data(), static_cast<int>(match.length())) : static_cast<Int64>(match.length());
+
+            return gcnew _Match(this, groupCount, input, inputIndex, capLength, charOffset, charOffset + static_cast<Int64>(match.length()), anchor);
+        }
+
+
+        _Match^ Regex::_nextMatch(_Match^ match)
+        {
+            /* A match anchored at both ends has already consumed the rest of the searched input. */
+            if(RegexAnchor::Both == match->_anchor)
+                return _Match::Empty;
+
+            RegexInput^ input  = match->_input;
+            bool        isUtf8 = input->IsByteInput ? false : input->IsUTF8;
+            Int64       start  = match->_nextpos;
+            Int64       index  = match->_index + match->_length;
+            Int64       end    = input->Length;
+
+            /* Explicitly advance the input start if the match is an empty string. */
+            if(!match->_length)
+                StepOverEmptyMatch(input->Data, end, isUtf8, &start, &index);
+
+            /* 
+             *  In .NET's Regex class matches are still attempted (and an empty match
+             *  can be successful) immediately after the last character of the input.
+             *  Thus start must be greater than end, and not simply equal to it.
+             */
+            if(start > end)
+                return _Match::Empty;
+
+            /*
+             *  The chain of matches shares one scratch array for its groups, created when the chain grows past its
+             *  first match, so that a Matches() loop doesn't contend with other searches for the Regex's own.
+             */
+            CaptureBuffer^ buffer = match->_captures;
+            if(!buffer && _re2->NumberOfCapturingGroups() && !RegexOption::HasAnyFlag(this->Options, RegexOptions::SingleCapture))
+                match->_captures = buffer = this->_newCaptureBuffer();
+
+            _Match^ rv = this->_match(input, start, end - start, index, match->_anchor);
+            if(rv->Success)
+                rv->_captures = buffer;
+
+            return rv;
+        }
+
+
+        void Regex::_matchGroups(_Match^ match, array<Int64>^ offsets)
+        {
+            RegexInput^    input    = match->_input;
+            int            count    = offsets->Length / 2;
+            CaptureBuffer^ buffer   = match->_captures ? match->_captures : _captures;
+            StringPiece*   captures = buffer->Rent();
+            pin_ptr<Byte>  bytes    = input->PinPerCall && input->Length ? &input->Bytes[0] : nullptr;
+            StringPiece    haystack(input->PinPerCall ? (const char*)bytes : input->Data, static_cast<size_t>(input->Length));
+            pin_ptr<Int64> pinned   = &offsets[0];
+
+            /*
+             *  Anchoring both ends to the span already found makes RE2 choose the same submatches it would
+             *  have chosen in the original unanchored search, while only running over the matched text. The
+             *  rest of the input is still passed in, so that '^', '$' and '\b' see the same context as before.
+             *
+             *  Groups always lie within the match, so CapturesToOffsets() counts their String indices from
+             *  the match's own index rather than from the beginning of the search.
+             */
+            if(_re2->Match(haystack, static_cast<size_t>(match->_textpos), static_cast<size_t>(match->_nextpos), RE2::ANCHOR_BOTH, captures, count))
+            {
+                bool isUtf8 = input->IsByteInput ? false : input->IsUTF8;
+                CapturesToOffsets<Int64>(haystack.data(), captures, count, match->_textpos, match->_index, isUtf8, pinned);
+            }
+            else
+            {
+                for(int i = 0; i < count; i++)
+                {
+                    pinned[2*i]     = -1;
+                    pinned[2*i + 1] = 0;
+                }
+            }
+
+            buffer->Return(captures);
+        }
+
+
+        _Match^ Regex::_scan(const StringPiece& text, Int64 startpos, Int64 origin, CaptureBuffer^ buffer)
+        {
+            /*
+             *  text is a window that begins at index origin of a longer byte input, which RegexScanner feeds
+             *  through one window at a time. The window moves on before the match could be searched again,
+             *  so its groups are found by the same search, and the match is created detached, holding a copy
+             *  of its own bytes and its indices in the longer input.
+             */
+            int          groupCount = RegexOption::HasAnyFlag(this->Options, RegexOptions::SingleCapture) ? 1 : 1 + _re2->NumberOfCapturingGroups();
+            StringPiece* captures   = buffer->Rent();
+
+            if(!Search(_re2, _lineAnchor, text, startpos, static_cast<Int64>(text.length()), RE2::UNANCHORED, captures, groupCount))
+            {
+                buffer->Return(captures);
+                return _Match::Empty;
+            }
+
+            array<Int64>^ offsets = gcnew array<Int64>(2 * groupCount);
+            {
+                pin_ptr<Int64> pinned = &offsets[0];
+                CapturesToOffsets<Int64>(text.data(), captures, groupCount, startpos, startpos, false, pinned);
+            }
+            buffer->Return(captures);
+
+            for(int i = 0; i < groupCount; i++)
+                if(offsets[2*i] >= 0)
+                    offsets[2*i] += origin;
+
+            Int64        index  = offsets[0];
+            array<Byte>^ span   = gcnew array<Byte>(static_cast<int>(offsets[1]));
+            if(span->Length)
+                Marshal::Copy(IntPtr(const_cast<char*>(text.data()) + (index - origin)), span, 0, span->Length);
+
+            RegexInput^ input = gcnew RegexInput(span, !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING), index);
+            _Match^     rv    = gcnew _Match(this, groupCount, input, index, offsets[1], 0, 0, RegexAnchor::None);
+            rv->_detached  = true;
+            rv->_groupcoll = gcnew GroupCollection(rv, offsets);
+
+            return rv;
+        }
+
+
+        _Match^ Regex::Match(String^ input, int startIndex, int length, RegexAnchor anchor)
+        {
+            int InputSize = input->Length;
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(startIndex < 0 || startIndex > InputSize)
+                throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
+            if(length < 0 || length > InputSize)
+                throw gcnew ArgumentOutOfRangeException("length", "Length cannot be less than 0 or greater than input length.");
+            if(startIndex + length - 1 > InputSize)
+                throw gcnew ArgumentOutOfRangeException("startIndex, length", "Start index and length combined cannot be greater than input length.");
+            if(anchor < RegexAnchor::None || anchor > RegexAnchor::Both)
+                throw gcnew ArgumentOutOfRangeException("anchor", "Anchor is not a valid RegexAnchor value.");
+            if(startIndex > 0)
+            {
+                pin_ptr<const wchar_t> chars = PtrToStringChars(input);
+                if((((char*)(&chars[startIndex]))[1] & 0xdc) == 0xdc)
+                    throw gcnew ArgumentException("startIndex", "Start index cannot bisect a UTF-16 surrogate pair.");
+            }
+            
+            /* If in UTF-8 mode, convert the start and length values from String^ to char* offset. */
+            bool isUtf8 = !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING);
+
+            RegexInput^ ri = CreateRegexInput(input, "input", this->Options, isUtf8);
+
+            int strStartIndex = startIndex;
+            if(isUtf8)
+            {
+                if(startIndex) startIndex = StrToCharPos(ri->Data, startIndex);
+                if(length)     length     = StrToCharPos(ri->Data + startIndex, length);
+            }
+
+            _Match^ rv = this->_match(ri, startIndex, length, strStartIndex, anchor);
+
+            /* No Match refers to the input, so it can be released now rather than by the finalizer. */
+            if(!rv->Success)
+                delete ri;
+
+            return rv;
+        }
+
+
+        _Match^ Regex::Match(array<Byte>^ input, int startIndex, int length, RegexAnchor anchor)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(startIndex < 0 || startIndex > input->Length)
+                throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
+            if(length < 0 || length > input->Length)
+                throw gcnew ArgumentOutOfRangeException("length", "Length cannot be less than 0 or greater than input length.");
+            if(startIndex + length - 1 > input->Length)
+                throw gcnew ArgumentOutOfRangeException("startIndex, length", "Start index and length combined cannot be greater than input length.");
+            if(anchor < RegexAnchor::None || anchor > RegexAnchor::Both)
+                throw gcnew ArgumentOutOfRangeException("anchor", "Anchor is not a valid RegexAnchor value.");
+
+            RegexInput^ ri = gcnew RegexInput(input, !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING), input->Length <= _byteCopyThreshold);
+
+            /* Unicode hijinks aren't required for byte arrays. */
+            _Match^ rv = this->_match(ri, startIndex, length, 0, anchor);
+
+            if(!rv->Success)
+                delete ri;
+
+            return rv;
+        }
+
+
+        _Match^ Regex::Match(String^ input, int startIndex, int length)
+        {
+            return this->Match(input, startIndex, length, RegexAnchor::None);
+        }
+
+
+        _Match^ Regex::Match(array<Byte>^ input, int startIndex, int length)
+        {
+            return this->Match(input, startIndex, length, RegexAnchor::None);
+        }
+
+
+        _Match^ Regex::MatchAt(String^ input, int position)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(position < 0 || position > input->Length)
+                throw gcnew ArgumentOutOfRangeException("position", "Position cannot be less than 0 or greater than input length.");
+
+            return this->Match(input, position, input->Length - position, RegexAnchor::Start);
+        }
+
+
+        _Match^ Regex::MatchAt(array<Byte>^ input, int position)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(position < 0 || position > input->Length)
+                throw gcnew ArgumentOutOfRangeException("position", "Position cannot be less than 0 or greater than input length.");
+
+            return this->Match(input, position, input->Length - position, RegexAnchor::Start);
+        }
+
+
+        _Match^ Regex::Match(String^ input, int startIndex)
+        {
+            return this->Match(input, startIndex, input->Length - startIndex);
+        }
+
+
+        _Match^ Regex::Match(array<Byte>^ input, int startIndex)
+        {
+            return this->Match(input, startIndex, input->Length - startIndex);
+        }
+
+
+        _Match^ Regex::Match(String^ input)
+        {
+            return this->Match(input, 0, input->Length);
+        }
+
+
+        _Match^ Regex::Match(array<Byte>^ input)
+        {
+            return this->Match(input, 0, input->Length);
+        }
+
+
+        _Match^ Regex::Match(IntPtr data, Int64 length, Action^ release)
+        {
+            CheckNativeInput(data, length);
+
+            RegexInput^ ri = gcnew RegexInput(data, length, !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING), release);
+            _Match^     rv = this->_match(ri, 0, length, 0, RegexAnchor::None);
+
+            /* Gives the memory back straight away if no Match refers to it. */
+            if(!rv->Success)
+                delete ri;
+
+            return rv;
+        }
+
+
+        _Match^ Regex::Match(IntPtr data, Int64 length)
+        {
+            return this->Match(data, length, nullptr);
+        }
+
+
+        _Match^ Regex::Match(array<Char>^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            return this->Match(ArraySegment<Char>(input));
+        }
+
+
+        _Match^ Regex::Match(ArraySegment<Char> input)
+        {
+            if(!input.Array)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            RegexInput^ ri = CreateRegexInput(input, "input", this->Options, !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING));
+            _Match^     rv = this->_match(ri, 0, ri->Length, 0, RegexAnchor::None);
+
+            if(!rv->Success)
+                delete ri;
+
+            return rv;
+        }
+
+
+        _Match^ Regex::Match(StringBuilder^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            RegexInput^ ri = CreateRegexInput(input, "input", this->Options, !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING));
+            _Match^     rv = this->_match(ri, 0, ri->Length, 0, RegexAnchor::None);
+
+            if(!rv->Success)
+                delete ri;
+
+            return rv;
+        }
+
+
+        _Match^ Regex::Match(String^ input, String^ pattern, RegexOptions options)
+        {
+            return Cache::FindOrCreate(pattern, options)->Match(input);
+        }
+
+
+        _Match^ Regex::Match(array<Byte>^ input, String^ pattern, RegexOptions options)
+        {
+            return Cache::FindOrCreate(pattern, options)->Match(input);
+        }
+
+
+        _Match^ Regex::Match(String^ input, String^ pattern)
+        {
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input);
+        }
+
+
+        _Match^ Regex::Match(array<Byte>^ input, String^ pattern)
+        {
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input);
+        }
+
+        #pragma endregion
+
+
+        #pragma region LastMatch
+
+        _Match^ Regex::_lastMatch(RegexInput^ input, Int64 strLength)
+        {
+            int           groupCount = RegexOption::HasAnyFlag(this->Options, RegexOptions::SingleCapture) ? 1 : 1 + _re2->NumberOfCapturingGroups();
+            pin_ptr<Byte> pinned     = input->PinPerCall && input->Length ? &input->Bytes[0] : nullptr;
+            StringPiece   match;
+            StringPiece   haystack(input->PinPerCall ? (const char*)pinned : input->Data, static_cast<size_t>(input->Length));
+
+            /* Ignore the encoding of input byte arrays. */
+            bool isUtf8 = input->IsByteInput ? false : input->IsUTF8;
+
+            if(!FindLast(_re2, haystack, isUtf8, &match))
+                return _Match::Empty;
+
+            /* The match is near the end, so count UTF-16 code units back from there rather than forward from the start. */
+            Int64 charOffset = match.data() - haystack.data();
+            Int64 inputIndex = isUtf8 ? strLength - CharToStrPos(match.data(), static_cast<int>(input->Length - charOffset)) : charOffset;
+            Int64 capLength  = isUtf8 ? CharToStrPos(match.data(), static_cast<int>(match.length())) : static_cast<Int64>(match.length());
+
+            return gcnew _Match(this, groupCount, input, inputIndex, capLength, charOffset, charOffset + static_cast<Int64>(match.length()), RegexAnchor::None);
+        }
+
+
+        _Match^ Regex::LastMatch(String^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            bool isUtf8 = !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING);
+
+            RegexInput^ ri = CreateRegexInput(input, "input", this->Options, isUtf8);
+
+            _Match^ rv = this->_lastMatch(ri, input->Length);
+
+            if(!rv->Success)
+                delete ri;
+
+            return rv;
+        }
+
+
+        _Match^ Regex::LastMatch(array<Byte>^ input)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            RegexInput^ ri = gcnew RegexInput(input, !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING), input->Length <= _byteCopyThreshold);
+
+            _Match^ rv = this->_lastMatch(ri, input->Length);
+
+            if(!rv->Success)
+                delete ri;
+
+            return rv;
+        }
+
+        #pragma endregion
+
+
+        #pragma region Matches
+
+        MatchCollection^ Regex::Matches(String^ input, int startIndex)
+        {
+            return gcnew MatchCollection(this->Match(input, startIndex, input->Length - startIndex));
         }
 
 
-        bool Regex::IsMatch(array<Byte>^ input, String^ pattern)
+        MatchCollection^ Regex::Matches(array<Byte>^ input, int startIndex)
         {
-            return Cache::FindOrCreate(pattern, RegexOptions::None)->IsMatch(input);
+            return gcnew MatchCollection(this->Match(input, startIndex, input->Length - startIndex));
         }
 
-        #pragma endregion
 
+        MatchCollection^ Regex::Matches(String^ input)
+        {
+            return gcnew MatchCollection(this->Match(input, 0, input->Length));
+        }
 
-        #pragma region Match
 
-        _Match^ Regex::_match(RegexInput^ input, int startIndex, int length, int strStartIndex)
+        MatchCollection^ Regex::Matches(array<Byte>^ input)
         {
-            /*
-             *  stringStartIndex tracks inputIndex for String inputs between matches to avoid recalculating
-             *  in CharToStrPos(), which is prohibitively costly for large inputs.
-             */
+            return gcnew MatchCollection(this->Match(input, 0, input->Length));
+        }
 
-            int          groupCount = RegexOption::HasAnyFlag(this->Options, RegexOptions::SingleCapture) ? 1 : 1 + _re2->NumberOfCapturingGroups();
-            StringPiece* captures   = new StringPiece[groupCount]();
-            StringPiece  haystack(input->Data, input->Length);
 
-            _Match^ rv = _Match::Empty;
-            if(_re2->Match(haystack, startIndex, startIndex + length, RE2::UNANCHORED, captures, groupCount))
+        MatchCollection^ Regex::Matches(IntPtr data, Int64 length)
+        {
+            return gcnew MatchCollection(this->Match(data, length, nullptr));
+        }
+
+
+        MatchCollection^ Regex::Matches(IntPtr data, Int64 length, Action^ release)
+        {
+            return gcnew MatchCollection(this->Match(data, length, release));
+        }
+
+
+        MatchCollection^ Regex::Matches(array<Char>^ input)
+        {
+            return gcnew MatchCollection(this->Match(input));
+        }
+
+
+        MatchCollection^ Regex::Matches(ArraySegment<Char> input)
+        {
+            return gcnew MatchCollection(this->Match(input));
+        }
+
+
+        MatchCollection^ Regex::Matches(StringBuilder^ input)
+        {
+            return gcnew MatchCollection(this->Match(input));
+        }
+
+
+        MatchCollection^ Regex::MatchesInFile(String^ path)
+        {
+            if(!path)
+                throw gcnew ArgumentNullException("path", "Value cannot be null.");
+
+            /* The mapping is closed through the release callback, once no Match refers to it. */
+            FileMapping^ mapping = FileMapping::Open(path);
+            try
+            {
+                return this->Matches(mapping->Data, mapping->Length, gcnew Action(mapping, &FileMapping::Release));
+            }
+            catch(Exception^)
             {
-                /* Ignore the encoding of input byte arrays. */
-                bool isUtf8     = input->Bytes ? false : input->IsUTF8;
-                int  charOffset = static_cast<int>(captures[0].data() - haystack.data());
-                int  inputIndex = isUtf8 && charOffset ? CharToStrPos(haystack.data() + startIndex, charOffset - startIndex) + strStartIndex : charOffset;
-                int  capLength  = isUtf8 ? CharToStrPos(captures[0].data(), captures[0].length()) : captures[0].length();
+                mapping->Release();
+                throw;
+            }
+        }
 
-                rv = gcnew _Match(this, groupCount, input, inputIndex, capLength, charOffset + captures[0].length());
 
-                GroupCollection^ groups = rv->Groups;
-                for(int i = 1; i < groupCount; i++)
-                {
-                    if(NULL == captures[i])
-                        groups[i] = Group::Empty;
-                    else
-                    {
-                        /*
-                         *  Match tracks the char offset and String index separately in case of UTF-8 String input, but
-                         *  they will be the same if the input is a Byte array, or if the Regex is ASCII or Latin-1.
-                         *
-                         *  There's room here to optimize calculation of the group indices. Currently it jumps back to
-                         *  the beginning of the search for each group, instead of adding incrementally onto the
-                         *  previous group's calculation.
-                         */
+        MatchCollection^ Regex::Matches(IEnumerable<ArraySegment<Byte>>^ segments, int maxMatchLength)
+        {
+            if(!segments)
+                throw gcnew ArgumentNullException("segments", "Value cannot be null.");
 
-                        charOffset = static_cast<int>(captures[i].data() - haystack.data());
-                        inputIndex = isUtf8 && charOffset ? CharToStrPos(haystack.data() + startIndex, charOffset - startIndex) + strStartIndex : charOffset;
-                        capLength  = isUtf8 ? CharToStrPos(captures[i].data(), captures[i].length()) : captures[i].length();
+            RegexScanner^    scanner = gcnew RegexScanner(this, maxMatchLength);
+            MatchCollection^ rv      = gcnew MatchCollection(_Match::Empty);
 
-                        groups[i] = gcnew Group(input, inputIndex, capLength);
-                    }
-                }
+            /* The matches are detached, so the collection is complete from the start. */
+            for each(ArraySegment<Byte> segment in segments)
+            {
+                if(!segment.Array)
+                    throw gcnew ArgumentException("Segments cannot have a null array.", "segments");
+
+                rv->_matches->AddRange(scanner->Append(segment.Array, segment.Offset, segment.Count));
             }
 
-            delete[] captures;
+            rv->_matches->AddRange(scanner->Finish());
 
             return rv;
         }
 
 
-        _Match^ Regex::Match(String^ input, int startIndex, int length)
+        MatchCollection^ Regex::Matches(String^ input, String^ pattern, RegexOptions options)
+        {
+            return gcnew MatchCollection(Cache::FindOrCreate(pattern, options)->Match(input, 0, input->Length));
+        }
+
+
+        MatchCollection^ Regex::Matches(array<Byte>^ input, String^ pattern, RegexOptions options)
+        {
+            return gcnew MatchCollection(Cache::FindOrCreate(pattern, options)->Match(input, 0, input->Length));
+        }
+
+
+        MatchCollection^ Regex::Matches(String^ input, String^ pattern)
+        {
+            return gcnew MatchCollection(Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input, 0, input->Length));
+        }
+
+
+        MatchCollection^ Regex::Matches(array<Byte>^ input, String^ pattern)
+        {
+            return gcnew MatchCollection(Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input, 0, input->Length));
+        }
+
+        #pragma endregion
+
+
+        #pragma region MatchesAsync
+
+        Task<MatchCollection^>^ Regex::MatchesAsync(Stream^ input, int bufferSize, int maxMatchLength)
+        {
+            return StreamSearch::Start(this, input, bufferSize, maxMatchLength);
+        }
+
+
+        Task<Int64>^ Regex::MatchesAsync(Stream^ input, int bufferSize, int maxMatchLength, Action<_Match^>^ match)
+        {
+            return StreamSearch::Start(this, input, bufferSize, maxMatchLength, match);
+        }
+
+        #pragma endregion
+
+
+        #pragma region EnumerateMatches
+
+        IEnumerable<_Match^>^ Regex::EnumerateMatches(String^ input, int startIndex)
+        {
+            return gcnew MatchStream(this->Match(input, startIndex, input->Length - startIndex));
+        }
+
+
+        IEnumerable<_Match^>^ Regex::EnumerateMatches(array<Byte>^ input, int startIndex)
+        {
+            return gcnew MatchStream(this->Match(input, startIndex, input->Length - startIndex));
+        }
+
+
+        IEnumerable<_Match^>^ Regex::EnumerateMatches(String^ input)
+        {
+            return gcnew MatchStream(this->Match(input, 0, input->Length));
+        }
+
+
+        IEnumerable<_Match^>^ Regex::EnumerateMatches(array<Byte>^ input)
+        {
+            return gcnew MatchStream(this->Match(input, 0, input->Length));
+        }
+
+
+        IEnumerable<_Match^>^ Regex::EnumerateMatches(String^ input, String^ pattern, RegexOptions options)
+        {
+            return gcnew MatchStream(Cache::FindOrCreate(pattern, options)->Match(input, 0, input->Length));
+        }
+
+
+        IEnumerable<_Match^>^ Regex::EnumerateMatches(array<Byte>^ input, String^ pattern, RegexOptions options)
+        {
+            return gcnew MatchStream(Cache::FindOrCreate(pattern, options)->Match(input, 0, input->Length));
+        }
+
+
+        IEnumerable<_Match^>^ Regex::EnumerateMatches(String^ input, String^ pattern)
+        {
+            return gcnew MatchStream(Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input, 0, input->Length));
+        }
+
+
+        IEnumerable<_Match^>^ Regex::EnumerateMatches(array<Byte>^ input, String^ pattern)
+        {
+            return gcnew MatchStream(Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input, 0, input->Length));
+        }
+
+        #pragma endregion
+
+        #pragma region Count
+
+        int Regex::_count(const StringPiece& haystack, int startIndex, int length, bool isUtf8)
+        {
+            return CountAll(_re2, _lineAnchor, haystack, startIndex, startIndex + length, isUtf8);
+        }
+
+
+        int Regex::Count(String^ input, int startIndex, int length)
         {
-            int InputSize = input->Length;
             if(!input)
                 throw gcnew ArgumentNullException("input", "Value cannot be null.");
-            if(startIndex < 0 || startIndex > InputSize)
+            if(startIndex < 0 || startIndex > input->Length)
                 throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
-            if(length < 0 || length > InputSize)
+            if(length < 0 || length > input->Length)
                 throw gcnew ArgumentOutOfRangeException("length", "Length cannot be less than 0 or greater than input length.");
-            if(startIndex + length - 1 > InputSize)
+            if(startIndex + length > input->Length)
                 throw gcnew ArgumentOutOfRangeException("startIndex, length", "Start index and length combined cannot be greater than input length.");
-            if(startIndex > 0)
-            {
-                pin_ptr<const wchar_t> chars = PtrToStringChars(input);
-                if((((char*)(&chars[startIndex]))[1] & 0xdc) == 0xdc)
-                    throw gcnew ArgumentException("startIndex", "Start index cannot bisect a UTF-16 surrogate pair.");
-            }
-            
-            /* If in UTF-8 mode, convert the start and length values from String^ to char* offset. */
-            bool isUtf8 = !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING);
+            if(startIndex > 0 && startIndex < input->Length && Char::IsLowSurrogate(input, startIndex))
+                throw gcnew ArgumentException("Start index cannot bisect a UTF-16 surrogate pair.", "startIndex");
 
-            StringPiece* sp = ConvertStringEncoding(input, "input", this->Options);
-            RegexInput^  ri = gcnew RegexInput(input, sp->data(), sp->length(), isUtf8);
-            delete sp;
+            ConvertedString converted;
+            ConvertStringEncoding(input, "input", this->Options, &converted);
 
-            int strStartIndex = startIndex;
+            bool        isUtf8 = !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING);
+            StringPiece sp     = converted.Piece();
+
+            /* In UTF-8 mode, convert the start and length values from String^ to char* offset. */
             if(isUtf8)
             {
-                if(startIndex) startIndex = StrToCharPos(ri->Data, startIndex);
-                if(length)     length     = StrToCharPos(ri->Data + startIndex, length);
+                if(startIndex) startIndex = StrToCharPos(sp.data(), startIndex);
+                if(length)     length     = StrToCharPos(sp.data() + startIndex, length);
             }
 
-            return this->_match(ri, startIndex, length, strStartIndex);
+            return this->_count(sp, startIndex, length, isUtf8);
         }
 
 
-        _Match^ Regex::Match(array<Byte>^ input, int startIndex, int length)
+        int Regex::Count(array<Byte>^ input, int startIndex, int length)
         {
             if(!input)
                 throw gcnew ArgumentNullException("input", "Value cannot be null.");
@@ -559,113 +1924,147 @@ namespace Net
                 throw gcnew ArgumentOutOfRangeException("startIndex", "Start index cannot be less than 0 or greater than input length.");
             if(length < 0 || length > input->Length)
                 throw gcnew ArgumentOutOfRangeException("length", "Length cannot be less than 0 or greater than input length.");
-            if(startIndex + length - 1 > input->Length)
+            if(startIndex + length > input->Length)
                 throw gcnew ArgumentOutOfRangeException("startIndex, length", "Start index and length combined cannot be greater than input length.");
 
-            RegexInput^ ri = gcnew RegexInput(input, !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING));
+            pin_ptr<Byte> bytes = input->Length ? &input[0] : nullptr;
+            StringPiece   sp((const char*)bytes, input->Length);
 
-            /* Unicode hijinks aren't required for byte arrays. */
-            return this->_match(ri, startIndex, length, 0);
+            return this->_count(sp, startIndex, length, false);
         }
 
 
-        _Match^ Regex::Match(String^ input, int startIndex)
+        int Regex::Count(String^ input)
         {
-            return this->Match(input, startIndex, input->Length - startIndex);
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            return this->Count(input, 0, input->Length);
         }
 
 
-        _Match^ Regex::Match(array<Byte>^ input, int startIndex)
+        int Regex::Count(array<Byte>^ input)
         {
-            return this->Match(input, startIndex, input->Length - startIndex);
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+
+            return this->Count(input, 0, input->Length);
         }
 
 
-        _Match^ Regex::Match(String^ input)
+        int Regex::Count(String^ input, String^ pattern, RegexOptions options)
         {
-            return this->Match(input, 0, input->Length);
+            return Cache::FindOrCreate(pattern, options)->Count(input);
         }
 
 
-        _Match^ Regex::Match(array<Byte>^ input)
+        int Regex::Count(array<Byte>^ input, String^ pattern, RegexOptions options)
         {
-            return this->Match(input, 0, input->Length);
+            return Cache::FindOrCreate(pattern, options)->Count(input);
         }
 
 
-        _Match^ Regex::Match(String^ input, String^ pattern, RegexOptions options)
+        int Regex::Count(String^ input, String^ pattern)
         {
-            return Cache::FindOrCreate(pattern, options)->Match(input);
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->Count(input);
         }
 
 
-        _Match^ Regex::Match(array<Byte>^ input, String^ pattern, RegexOptions options)
+        int Regex::Count(array<Byte>^ input, String^ pattern)
         {
-            return Cache::FindOrCreate(pattern, options)->Match(input);
+            return Cache::FindOrCreate(pattern, RegexOptions::None)->Count(input);
         }
 
+        #pragma endregion
 
-        _Match^ Regex::Match(String^ input, String^ pattern)
-        {
-            return Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input);
-        }
 
+        #pragma region MatchLines
 
-        _Match^ Regex::Match(array<Byte>^ input, String^ pattern)
+        int Regex::_matchLines(const StringPiece& haystack, bool isUtf8, bool invert, array<int>^ lines, int capacity)
         {
-            return Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input);
+            pin_ptr<int> out = lines && lines->Length ? &lines[0] : nullptr;
+            return MatchLinesIn(_re2, _lineAnchor, haystack, isUtf8, invert, lines ? out : NULL, capacity);
         }
 
-        #pragma endregion
 
+        int Regex::MatchLines(String^ input, array<int>^ lines, bool invert)
+        {
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(!lines)
+                throw gcnew ArgumentNullException("lines", "Value cannot be null.");
 
-        #pragma region Matches
+            ConvertedString converted;
+            ConvertStringEncoding(input, "input", this->Options, &converted);
 
-        MatchCollection^ Regex::Matches(String^ input, int startIndex)
-        {
-            return gcnew MatchCollection(this->Match(input, startIndex, input->Length - startIndex));
+            bool isUtf8 = !RegexOption::HasAnyFlag(this->Options, SINGLE_BYTE_ENCODING);
+            return this->_matchLines(converted.Piece(), isUtf8, invert, lines, lines->Length / 3);
         }
 
 
-        MatchCollection^ Regex::Matches(array<Byte>^ input, int startIndex)
+        int Regex::MatchLines(array<Byte>^ input, array<int>^ lines, bool invert)
         {
-            return gcnew MatchCollection(this->Match(input, startIndex, input->Length - startIndex));
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(!lines)
+                throw gcnew ArgumentNullException("lines", "Value cannot be null.");
+
+            pin_ptr<Byte> bytes = input->Length ? &input[0] : nullptr;
+            StringPiece   sp((const char*)bytes, input->Length);
+
+            return this->_matchLines(sp, false, invert, lines, lines->Length / 3);
         }
 
 
-        MatchCollection^ Regex::Matches(String^ input)
+        int Regex::MatchLines(String^ input, array<int>^ lines)
         {
-            return gcnew MatchCollection(this->Match(input, 0, input->Length));
+            return this->MatchLines(input, lines, false);
         }
 
 
-        MatchCollection^ Regex::Matches(array<Byte>^ input)
+        int Regex::MatchLines(array<Byte>^ input, array<int>^ lines)
         {
-            return gcnew MatchCollection(this->Match(input, 0, input->Length));
+            return this->MatchLines(input, lines, false);
         }
 
 
-        MatchCollection^ Regex::Matches(String^ input, String^ pattern, RegexOptions options)
+        int Regex::CountLines(String^ input, bool invert, int maxCount)
         {
-            return gcnew MatchCollection(Cache::FindOrCreate(pattern, options)->Match(input, 0, input->Length));
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(maxCount < 0)
+                throw gcnew ArgumentOutOfRangeException("maxCount", "Maximum count cannot be less than 0.");
+
+            ConvertedString converted;
+            ConvertStringEncoding(input, "input", this->Options, &converted);
+
+            return this->_matchLines(converted.Piece(), false, invert, nullptr, maxCount);
         }
 
 
-        MatchCollection^ Regex::Matches(array<Byte>^ input, String^ pattern, RegexOptions options)
+        int Regex::CountLines(array<Byte>^ input, bool invert, int maxCount)
         {
-            return gcnew MatchCollection(Cache::FindOrCreate(pattern, options)->Match(input, 0, input->Length));
+            if(!input)
+                throw gcnew ArgumentNullException("input", "Value cannot be null.");
+            if(maxCount < 0)
+                throw gcnew ArgumentOutOfRangeException("maxCount", "Maximum count cannot be less than 0.");
+
+            pin_ptr<Byte> bytes = input->Length ? &input[0] : nullptr;
+            StringPiece   sp((const char*)bytes, input->Length);
+
+            return this->_matchLines(sp, false, invert, nullptr, maxCount);
         }
 
 
-        MatchCollection^ Regex::Matches(String^ input, String^ pattern)
+        int Regex::CountLines(String^ input)
         {
-            return gcnew MatchCollection(Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input, 0, input->Length));
+            return this->CountLines(input, false, Int32::MaxValue);
         }
 
 
-        MatchCollection^ Regex::Matches(array<Byte>^ input, String^ pattern)
+        int Regex::CountLines(array<Byte>^ input)
         {
-            return gcnew MatchCollection(Cache::FindOrCreate(pattern, RegexOptions::None)->Match(input, 0, input->Length));
+            return this->CountLines(input, false, Int32::MaxValue);
         }
 
         #pragma endregion
@@ -675,8 +2074,47 @@ namespace Net
 
     #pragma region Regex constructors and cleanup
 
+        /*
+         *  Returns a LineAnchor (see SearchLineStarts()) if every match of the pattern must begin at a line
+         *  start, or NULL otherwise. The test is deliberately conservative: the pattern must begin with '^',
+         *  which mustn't be quantified, and must contain no alternation, since an alternative might not begin
+         *  with '^'. The literal prefix is limited to ASCII, which is encoded identically in UTF-8 and Latin-1.
+         */
+        static LineAnchor* CreateLineAnchor(String^ pattern, RegexOptions options)
+        {
+            if(!RegexOption::HasAnyFlag(options, RegexOptions::Multiline)
+               || RegexOption::HasAnyFlag(options, RegexOptions::Literal | RegexOptions::OneLine))
+                return NULL;
+            String^ quantifiers = "*+?{";
+            String^ optional    = "*?{";
+            String^ special     = "\\.[](){}*+?|^$";
+
+            if(pattern->Length < 2 || '^' != pattern[0] || -1 != pattern->IndexOf('|') || -1 != quantifiers->IndexOf(pattern[1]))
+                return NULL;
+
+            int length = 0;
+            if(!RegexOption::HasAnyFlag(options, RegexOptions::IgnoreCase))
+            {
+                while(1 + length < pattern->Length && pattern[1 + length] < 0x80 && -1 == special->IndexOf(pattern[1 + length]))
+                    ++length;
+
+                /* A quantifier that allows zero repetitions makes the last literal character optional. */
+                if(length && 1 + length < pattern->Length && -1 != optional->IndexOf(pattern[1 + length]))
+                    --length;
+            }
+
+            LineAnchor* rv = new LineAnchor();
+            rv->prefix = static_cast<char*>(malloc(length + 1));
+            rv->length = length;
+            for(int i = 0; i < length; i++)
+                rv->prefix[i] = static_cast<char>(pattern[1 + i]);
+
+            return rv;
+        }
+
+
         Regex::Regex(String^ pattern, RegexOptions options, int maxMemory)
-            : _re2(nullptr), _pattern(pattern), _options(options), _maxMemory(maxMemory)
+            : _re2(nullptr), _captures(nullptr), _lineAnchor(nullptr), _pattern(pattern), _options(options), _maxMemory(maxMemory)
         {
             if(!pattern)
                 throw gcnew ArgumentNullException("pattern", "Value cannot be null.");
@@ -746,21 +2184,43 @@ namespace Net
                 }
             }
                 
-            /*
-             *  The RE2 ctor creates a local copy of the pattern, thus there is no reason to preserve it.
-             *  A StringPiece doesn't take ownership of its contents, however, so the underlying data has
-             *  to be freed manually.
-             */
-            StringPiece* regex = ConvertStringEncoding(pattern, "pattern", options);
-            _re2 = new RE2(*regex, settings);
-            free(const_cast<char*>(regex->data()));
-            delete regex;
+            /* The RE2 ctor creates a local copy of the pattern, thus there is no reason to preserve it. */
+            {
+                ConvertedString regex;
+                ConvertStringEncoding(pattern, "pattern", options, &regex);
+                _re2 = new RE2(regex.Piece(), settings);
+            }
 
             if(!_re2->ok())
                 throw gcnew ArgumentException(String::Format("{0}: '{1}' in pattern '{2}'.",
                                                              _errorTable[_re2->error_code()],
                                                              CharToString(_re2->error_arg(), settings.utf8()),
                                                              Pattern));
+
+            _captures = this->_newCaptureBuffer();
+
+            /*
+             *  GroupCollection looks names up on every named access, so both directions are tabulated once here
+             *  rather than copying RE2's std::map and transcoding the name on each call.
+             */
+            int groupCount = 1 + _re2->NumberOfCapturingGroups();
+            _groupNames    = gcnew array<String^>(groupCount);
+            _groupNumbers  = gcnew Dictionary<String^, int>(groupCount, StringComparer::Ordinal);
+
+            for(int i = 0; i < groupCount; i++)
+            {
+                _groupNames[i] = i.ToString();
+                _groupNumbers[_groupNames[i]] = i;
+            }
+
+            const map<int, string>& names = _re2->CapturingGroupNames();
+            for(map<int, string>::const_iterator it = names.begin(); it != names.end(); ++it)
+            {
+                _groupNames[it->first] = CharToString(it->second, settings.utf8());
+                _groupNumbers[_groupNames[it->first]] = it->first;
+            }
+
+            _lineAnchor = CreateLineAnchor(Pattern, options);
         }
 
 
@@ -798,6 +2258,8 @@ namespace Net
 
         Regex::~Regex()
         {
+            /* The buffer has a finalizer of its own, so only a Dispose() releases it from here. */
+            delete _captures;
             this->!Regex();
         }
 
@@ -806,6 +2268,13 @@ namespace Net
         {
             if(_re2)
                 delete _re2;
+
+            if(_lineAnchor)
+            {
+                free(_lineAnchor->prefix);
+                delete _lineAnchor;
+                _lineAnchor = nullptr;
+            }
         }
 
     #pragma endregion
@@ -47,6 +47,17 @@
  *      default of 8 MB is enough to handle all but the most complex
  *      expressions. For larger value, simply use instance rather than
  *      static methods.
+ *
+ *  [+] Ahead-of-time compilation of fixed patterns into static DFA tables
+ *      isn't supported. RE2 builds its DFA states lazily, at match time,
+ *      from a Prog that is only reachable through internal headers (prog.h,
+ *      dfa.cc) which re2.h doesn't expose, and the states themselves depend
+ *      on the input seen so far. Generating native tables would mean either
+ *      forking RE2 or writing a second regex compiler, neither of which
+ *      belongs in a wrapper. Patterns that never change should be held in
+ *      static Regex instances (or go through the static method cache), so
+ *      that each process pays the compile cost once and every later match
+ *      reuses the DFA states that RE2 has already built.
  */
 
 #pragma once
@@ -104,6 +115,8 @@
     #include "re2\re2.h"
 #pragma managed(pop)
 
+#include "CaptureBuffer.h"
+#include "RegexAnchor.h"
 #include "RegexOptions.h"
 #include "RegexInput.h"
 #include "Match.h"
@@ -115,16 +128,23 @@ namespace Re2
 namespace Net
 {
     using namespace System;
+    using namespace System::Threading::Tasks;
 
     using System::Collections::Generic::Dictionary;
+    using System::Collections::Generic::IEnumerable;
     using System::Collections::Generic::List;
+    using System::IO::Stream;
+    using System::Text::StringBuilder;
 
     using re2::RE2;
     using re2::StringPiece;
 
+    ref class CaptureBuffer;
     ref class Match;
     ref class MatchCollection;
 
+    struct LineAnchor;
+
     /*
      *  The compiler is unable to distinguish between types and members
      *  that share a name. Aliasing is used throughout the project to
@@ -149,6 +169,22 @@ namespace Net
             const RE2* _re2;
 
 
+            /*
+             *  _captures : The scratch array for the submatches of _tryMatch() and _matchOffsets(), and of
+             *              _matchGroups() for a match that isn't part of a chain. Matches found by NextMatch()
+             *              share a buffer of their own, as does each RegexScanner; see CaptureBuffer.h.
+             */
+            CaptureBuffer^ _captures;
+
+
+            /*
+             *  _lineAnchor : Set for Multiline patterns that can only match at the start of a line, so that
+             *                searches can skip to the first line start that might match before calling RE2.
+             *                NULL for all other patterns. See SearchLineStarts() in Regex.cpp.
+             */
+            LineAnchor* _lineAnchor;
+
+
             /*
              *  REGEX_OPTIONS_MAX    : The upper bound on valid RegexOptions input. The lower bound is
              *                         always zero, represented by RegexOptions::None.
@@ -225,6 +261,19 @@ namespace Net
             initonly String^      _pattern;
             initonly RegexOptions _options;
 
+            /*
+             *  _groupNames   : The name of each group, indexed by group number. Unnamed groups are named by
+             *                  their numbers, as in .NET.
+             *
+             *  _groupNumbers : The number of each group, keyed by name and also by number as a string. Both
+             *                  tables are built by the constructor and never change afterwards.
+             */
+            initonly array<String^>^           _groupNames;
+            initonly Dictionary<String^, int>^ _groupNumbers;
+
+            /* The default is the size at which the CLR allocates arrays on the large object heap, which is never compacted. */
+            static int _byteCopyThreshold = 85000;
+
         public:
             
             /// <summary>
@@ -254,6 +303,34 @@ namespace Net
             property int MaxMemory { int get(); }
 
 
+            /// <summary>
+            ///     Gets or sets the largest input byte array, in bytes, that is copied into native memory rather than pinned.
+            /// </summary>
+            /// <value>
+            ///     The largest input byte array that is copied. The default is 85000, below which the runtime allocates arrays on its
+            ///     compacting heaps.
+            /// </value>
+            /// <remarks>
+            ///     <para>
+            ///         A <see cref="Match"/> found in a byte array can search it again through <see cref="Match::NextMatch"/>. If the
+            ///         array stayed pinned for the life of the match, many pinned arrays would fragment the managed heap. Arrays up to
+            ///         this size are copied instead, once, into pooled native memory.
+            ///     </para>
+            ///     <para>
+            ///         Larger arrays are not copied. They are pinned only while each search runs and are free to move in between. Set
+            ///         the threshold to 0 to never copy, or to <see cref="Int32::MaxValue"/> to always copy.
+            ///     </para>
+            /// </remarks>
+            /// <exception cref="System::ArgumentOutOfRangeException">
+            ///     <paramref name="value"/> is less than zero.
+            /// </exception>
+            static property int ByteCopyThreshold
+            {
+                int  get();
+                void set(int value);
+            }
+
+
             /// <summary>
             ///     Returns the regular expression pattern that was passed into the <c>Regex</c> constructor.
             /// </summary>
@@ -265,16 +342,40 @@ namespace Net
             ///     Returns the group number that corresponds to the specified group name.
             /// </summary>
             /// <param name="name">The group name to convert to the corresponding group number.</param>
+            /// <returns>
+            ///     The group number that corresponds to <paramref name="name"/>, or -1 if <paramref name="name"/> is not a valid group
+            ///     name. Every group can also be found by its number as a string, e.g. "1".
+            /// </returns>
             /// <exception cref="System::ArgumentNullException">
             ///     <paramref name="name"/> is <c>null</c>.
             /// </exception>
-            /// <exception cref="System::ArgumentOutOfRangeException">
-            ///     <para><paramref name="name"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
-            ///     <para>- or -</para>
-            ///     <para><paramref name="name"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
-            /// </exception>
             int GroupNumberFromName(String^ name);
 
+
+            /// <summary>
+            ///     Gets the group name that corresponds to the specified group number.
+            /// </summary>
+            /// <param name="i">The group number to convert to the corresponding group name.</param>
+            /// <returns>
+            ///     The group name that corresponds to <paramref name="i"/>, or <c>String.Empty</c> if <paramref name="i"/> is not a valid
+            ///     group number. Unnamed groups are named by their numbers.
+            /// </returns>
+            String^ GroupNameFromNumber(int i);
+
+
+            /// <summary>
+            ///     Returns an array of capturing group names for the regular expression.
+            /// </summary>
+            /// <returns>A string array of group names, in group number order. Unnamed groups are named by their numbers.</returns>
+            array<String^>^ GetGroupNames();
+
+
+            /// <summary>
+            ///     Returns an array of capturing group numbers that correspond to group names in an array.
+            /// </summary>
+            /// <returns>An integer array of group numbers, from 0 to the number of capturing groups.</returns>
+            array<int>^ GetGroupNumbers();
+
         #pragma endregion
 
 
@@ -349,6 +450,111 @@ namespace Net
                 bool IsMatch(array<Byte>^ input);
 
 
+                /// <summary>
+                ///     Indicates whether the regular expression specified in the <see cref="Regex"/> constructor finds a match in the specified
+                ///     block of native memory.
+                /// </summary>
+                /// <param name="data">A pointer to the bytes to search for a match.</param>
+                /// <param name="length">The number of bytes to search.</param>
+                /// <returns><c>true</c> if the regular expression finds a match; otherwise, <c>false</c>.</returns>
+                /// <remarks>
+                ///     The memory is searched in place, as a byte array would be, with no copy or pinning.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="data"/> is <c>IntPtr.Zero</c> and <paramref name="length"/> is greater than zero.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="length"/> is less than zero or greater than the address space of the process.
+                /// </exception>
+                bool IsMatch(IntPtr data, Int64 length);
+
+
+                /// <summary>
+                ///     Indicates whether the regular expression specified in the <see cref="Regex"/> constructor finds a match in the specified
+                ///     input char array.
+                /// </summary>
+                /// <param name="input">The char array to search for a match.</param>
+                /// <returns><c>true</c> if the regular expression finds a match; otherwise, <c>false</c>.</returns>
+                /// <remarks>
+                ///     The array is transcoded directly, as a string would be, and indices are counted from its first char.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                bool IsMatch(array<Char>^ input);
+
+
+                /// <summary>
+                ///     Indicates whether the regular expression specified in the <see cref="Regex"/> constructor finds a match in the specified
+                ///     input char array segment.
+                /// </summary>
+                /// <param name="input">The char array segment to search for a match.</param>
+                /// <returns><c>true</c> if the regular expression finds a match; otherwise, <c>false</c>.</returns>
+                /// <remarks>
+                ///     The segment is transcoded directly, as a string would be, and indices are counted from its first char.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     The array of <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                bool IsMatch(ArraySegment<Char> input);
+
+
+                /// <summary>
+                ///     Indicates whether the regular expression specified in the <see cref="Regex"/> constructor finds a match in the specified
+                ///     input string builder.
+                /// </summary>
+                /// <param name="input">The string builder to search for a match.</param>
+                /// <returns><c>true</c> if the regular expression finds a match; otherwise, <c>false</c>.</returns>
+                /// <remarks>
+                ///     The builder is transcoded a block at a time, without first being converted to a string, and indices are the same as
+                ///     in the string it holds.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                bool IsMatch(StringBuilder^ input);
+
+
+                /// <summary>
+                ///     Indicates whether the regular expression specified in the <see cref="Regex"/> constructor finds a match in the
+                ///     specified file.
+                /// </summary>
+                /// <param name="path">The file to search for a match.</param>
+                /// <returns><c>true</c> if the regular expression finds a match; otherwise, <c>false</c>.</returns>
+                /// <remarks>
+                ///     The file is mapped into memory read-only and searched in place, as a byte array would be, without being read into
+                ///     one. The mapping is closed before the method returns.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="path"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::IO::FileNotFoundException">
+                ///     The file specified by <paramref name="path"/> doesn't exist.
+                /// </exception>
+                /// <exception cref="System::IO::IOException">
+                ///     The file can't be opened or mapped.
+                /// </exception>
+                /// <exception cref="System::UnauthorizedAccessException">
+                ///     The caller doesn't have permission to read the file.
+                /// </exception>
+                bool IsMatchInFile(String^ path);
+
+
                 /// <summary>
                 ///     Indicates whether the specified regular expression finds a match in the specified input string,
                 ///     using the specified matching options.
@@ -440,105 +646,16 @@ namespace Net
                 static bool IsMatch(array<Byte>^ input, String^ pattern);
                 /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
 
-            #pragma endregion
-
-
-            #pragma region Match
-
-            internal:
-                
-                _Match^ _match(RegexInput^ input, int startIndex, int length, int stringStartIndex);
-
-
-            public:
-
-                /// <summary>
-                ///     Searches the input string for the first occurrence of a regular expression, beginning at the specified starting
-                ///     position and searching only the specified number of characters.
-                /// </summary>
-                /// <param name="input">The string to search for a match.</param>
-                /// <param name="startIndex">The input index at which to start the search.</param>
-                /// <param name="length">The number of characters in the substring to include in the search.</param>
-                /// <returns>An object that contains information about the match.</returns>
-                /// <exception cref="System::ArgumentNullException">
-                ///     <paramref name="input"/> is <c>null</c>.
-                /// </exception>
-                /// <exception cref="System::ArgumentOutOfRangeException">
-                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
-                ///     <para>- or -</para>
-                ///     <para><paramref name="length"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
-                ///     <para>- or -</para>
-                ///     <para><c><paramref name="startIndex"/> + <paramref name="length"/> - 1</c> identifies a position that is outside the range of <paramref name="input"/>.</para>
-                ///     <para>- or -</para>
-                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
-                ///     <para>- or -</para>
-                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
-                /// </exception>
-                _Match^ Match(String^ input, int startIndex, int length);
-                
-
-                /// <summary>
-                ///     Searches the input byte array for the first occurrence of a regular expression, beginning at the specified starting
-                ///     position and searching only the specified number of bytes.
-                /// </summary>
-                /// <param name="input">The byte array to search for a match.</param>
-                /// <param name="startIndex">The input index at which to start the search.</param>
-                /// <param name="length">The number of bytes in the input to include in the search.</param>
-                /// <returns>An object that contains information about the match.</returns>
-                /// <exception cref="System::ArgumentNullException">
-                ///     <paramref name="input"/> is <c>null</c>.
-                /// </exception>
-                /// <exception cref="System::ArgumentOutOfRangeException">
-                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
-                ///     <para>- or -</para>
-                ///     <para><paramref name="length"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
-                ///     <para>- or -</para>
-                ///     <para><c><paramref name="startIndex"/> + <paramref name="length"/> - 1</c> identifies a position that is outside the range of <paramref name="input"/>.</para>
-                /// </exception>
-                _Match^ Match(array<Byte>^ input, int startIndex, int length);
-                
-
-                /// <summary>
-                ///     Searches the input string for the first occurrence of a regular expression, beginning at the specified starting
-                ///     position in the string.
-                /// </summary>
-                /// <param name="input">The string to search for a match.</param>
-                /// <param name="startIndex">The zero-based input index at which to start the search.</param>
-                /// <returns>An object that contains information about the match.</returns>
-                /// <exception cref="System::ArgumentNullException">
-                ///     <paramref name="input"/> is <c>null</c>.
-                /// </exception>
-                /// <exception cref="System::ArgumentOutOfRangeException">
-                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
-                ///     <para>- or -</para>
-                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
-                ///     <para>- or -</para>
-                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
-                /// </exception>
-                _Match^ Match(String^ input, int startIndex);
-                
-
-                /// <summary>
-                ///     Searches the input byte array for the first occurrence of a regular expression, beginning at the specified starting
-                ///     position.
-                /// </summary>
-                /// <param name="input">The byte array to search for a match.</param>
-                /// <param name="startIndex">The input index at which to start the search.</param>
-                /// <returns>An object that contains information about the match.</returns>
-                /// <exception cref="System::ArgumentNullException">
-                ///     <paramref name="input"/> is <c>null</c>.
-                /// </exception>
-                /// <exception cref="System::ArgumentOutOfRangeException">
-                ///     <paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.
-                /// </exception>
-                _Match^ Match(array<Byte>^ input, int startIndex);
-
 
                 /// <summary>
-                ///     Searches the input string for the first occurrence of a regular expression.
+                ///     Indicates whether the regular expression matches the whole of the input string.
                 /// </summary>
-                /// <param name="input">The string to search for a match.</param>
-                /// <returns>An object that contains information about the match.</returns>
+                /// <param name="input">The string to test.</param>
+                /// <returns><c>true</c> if the regular expression matches all of <paramref name="input"/>; otherwise, <c>false</c>.</returns>
+                /// <remarks>
+                ///     The search is anchored at both ends of <paramref name="input"/>, which is much cheaper than wrapping the pattern
+                ///     in '^' and '$' and calling <see cref="IsMatch(String^)"/>.
+                /// </remarks>
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> is <c>null</c>.
                 /// </exception>
@@ -547,30 +664,35 @@ namespace Net
                 ///     <para>- or -</para>
                 ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
-                _Match^ Match(String^ input);
+                bool IsFullMatch(String^ input);
 
 
                 /// <summary>
-                ///     Searches the input byte array for the first occurrence of a regular expression.
+                ///     Indicates whether the regular expression matches the whole of the input byte array.
                 /// </summary>
-                /// <param name="input">The byte array to search for a match.</param>
-                /// <returns>An object that contains information about the match.</returns>
+                /// <param name="input">The byte array to test.</param>
+                /// <returns><c>true</c> if the regular expression matches all of <paramref name="input"/>; otherwise, <c>false</c>.</returns>
+                /// <remarks>
+                ///     The search is anchored at both ends of <paramref name="input"/>, which is much cheaper than wrapping the pattern
+                ///     in '^' and '$' and calling <see cref="IsMatch(array&lt;Byte&gt;^)"/>.
+                /// </remarks>
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> is <c>null</c>.
                 /// </exception>
-                _Match^ Match(array<Byte>^ input);
+                bool IsFullMatch(array<Byte>^ input);
 
 
                 /// <summary>
-                ///     Searches the input string for the first occurrence of the specified regular expression, using the specified matching options.
+                ///     Indicates whether the specified regular expression matches the whole of the specified input string, using the
+                ///     specified matching options.
                 /// </summary>
-                /// <param name="input">The string to search for a match.</param>
+                /// <param name="input">The string to test.</param>
                 /// <param name="pattern">
                 ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
                 ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
                 /// </param>
                 /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
-                /// <returns>An object that contains information about the match.</returns>
+                /// <returns><c>true</c> if the regular expression matches all of <paramref name="input"/>; otherwise, <c>false</c>.</returns>
                 /// <exception cref="System::ArgumentException">
                 ///     A regular expression parsing error occurred.
                 /// </exception>
@@ -584,19 +706,20 @@ namespace Net
                 ///     <para>- or -</para>
                 ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
-                static _Match^ Match(String^ input, String^ pattern, RegexOptions options);
+                static bool IsFullMatch(String^ input, String^ pattern, RegexOptions options);
 
 
                 /// <summary>
-                ///     Searches the input byte array for the first occurrence of the specified regular expression, using the specified matching options.
+                ///     Indicates whether the specified regular expression matches the whole of the specified input byte array, using
+                ///     the specified matching options.
                 /// </summary>
-                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="input">The byte array to test.</param>
                 /// <param name="pattern">
                 ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
                 ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
                 /// </param>
                 /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
-                /// <returns>An object that contains information about the match.</returns>
+                /// <returns><c>true</c> if the regular expression matches all of <paramref name="input"/>; otherwise, <c>false</c>.</returns>
                 /// <exception cref="System::ArgumentException">
                 ///     A regular expression parsing error occurred.
                 /// </exception>
@@ -604,74 +727,87 @@ namespace Net
                 ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
                 /// </exception>
                 /// <exception cref="System::ArgumentOutOfRangeException">
-                ///     <paramref name="options"/> is not a valid <c>RegexOptions</c> value.
+                ///     <para><paramref name="options"/> is not a valid <c>RegexOptions</c> value.</para>
                 ///     <para>- or -</para>
                 ///     <para><paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
                 ///     <para>- or -</para>
                 ///     <para><paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
-                static _Match^ Match(array<Byte>^ input, String^ pattern, RegexOptions options);
+                static bool IsFullMatch(array<Byte>^ input, String^ pattern, RegexOptions options);
 
 
                 /// <summary>
-                ///     Searches the input string for the first occurrence of the specified regular expression.
+                ///     Indicates whether the specified regular expression matches the whole of the specified input string.
                 /// </summary>
-                /// <param name="input">The string to search for a match.</param>
+                /// <param name="input">The string to test.</param>
                 /// <param name="pattern">
                 ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
                 ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
                 /// </param>
-                /// <returns>An object that contains information about the match.</returns>
+                /// <returns><c>true</c> if the regular expression matches all of <paramref name="input"/>; otherwise, <c>false</c>.</returns>
                 /// <exception cref="System::ArgumentException">
                 ///     A regular expression parsing error occurred.
                 /// </exception>
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
                 /// </exception>
-                /// <exception cref="System::ArgumentOutOfRangeException">
-                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
-                ///     <para>- or -</para>
-                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
-                /// </exception>
-                static _Match^ Match(String^ input, String^ pattern);
+                static bool IsFullMatch(String^ input, String^ pattern);
                 /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
 
 
                 /// <summary>
-                ///     Searches the input byte array for the first occurrence of the specified regular expression.
+                ///     Indicates whether the specified regular expression matches the whole of the specified input byte array.
                 /// </summary>
-                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="input">The byte array to test.</param>
                 /// <param name="pattern">
                 ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
                 ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
                 /// </param>
-                /// <returns>An object that contains information about the match.</returns>
+                /// <returns><c>true</c> if the regular expression matches all of <paramref name="input"/>; otherwise, <c>false</c>.</returns>
                 /// <exception cref="System::ArgumentException">
                 ///     A regular expression parsing error occurred.
                 /// </exception>
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
                 /// </exception>
-                static _Match^ Match(array<Byte>^ input, String^ pattern);
+                static bool IsFullMatch(array<Byte>^ input, String^ pattern);
                 /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
 
             #pragma endregion
 
 
-            #pragma region Matches
+            #pragma region TryMatch
+
+            private:
+
+                bool _tryMatch(const StringPiece& haystack, int startIndex, int stringStartIndex, bool isUtf8, array<int>^ offsets);
+
+
+            public:
 
                 /// <summary>
-                ///     Searches the specified input string for all occurrences of a regular expression, beginning at the specified
-                ///     starting position in the string.
+                ///     Searches the input string for the first occurrence of a regular expression, beginning at the specified starting
+                ///     position, and writes the position of the match and of each group into a caller-supplied array.
                 /// </summary>
                 /// <param name="input">The string to search for a match.</param>
                 /// <param name="startIndex">The input index at which to start the search.</param>
-                /// <returns>
-                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
-                ///     returns an empty collection object.
-                /// </returns>
+                /// <param name="offsets">
+                ///     An array that receives an (index, length) pair for the match, followed by one pair for each group that fits.
+                ///     Groups that did not participate in the match are given an index of -1 and a length of 0. Elements past the
+                ///     last group are left untouched.
+                /// </param>
+                /// <returns><c>true</c> if the regular expression finds a match; otherwise, <c>false</c>.</returns>
+                /// <remarks>
+                ///     No managed objects are allocated. Groups are only searched for if <paramref name="offsets"/> has room for
+                ///     them, so an array of two elements is the cheapest way to locate a match.
+                /// </remarks>
+                /// <exception cref="System::ArgumentException">
+                ///     <para><paramref name="offsets"/> has fewer than two elements.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="startIndex"/> bisects a UTF-16 surrogate pair.</para>
+                /// </exception>
                 /// <exception cref="System::ArgumentNullException">
-                ///     <paramref name="input"/> is <c>null</c>.
+                ///     <paramref name="input"/> or <paramref name="offsets"/> is <c>null</c>.
                 /// </exception>
                 /// <exception cref="System::ArgumentOutOfRangeException">
                 ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
@@ -680,36 +816,1188 @@ namespace Net
                 ///     <para>- or -</para>
                 ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
-                MatchCollection^ Matches(String^ input, int startIndex);
+                bool TryMatch(String^ input, int startIndex, array<int>^ offsets);
 
 
                 /// <summary>
-                ///     Searches the specified input byte array for all occurrences of a regular expression, beginning at the specified
-                ///     starting position.
+                ///     Searches the input byte array for the first occurrence of a regular expression, beginning at the specified starting
+                ///     position, and writes the position of the match and of each group into a caller-supplied array.
                 /// </summary>
                 /// <param name="input">The byte array to search for a match.</param>
                 /// <param name="startIndex">The input index at which to start the search.</param>
-                /// <returns>
-                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
-                ///     returns an empty collection object.
-                /// </returns>
-                /// <exception cref="System::ArgumentNullException">
+                /// <param name="offsets">
+                ///     An array that receives an (index, length) pair for the match, followed by one pair for each group that fits.
+                ///     Groups that did not participate in the match are given an index of -1 and a length of 0. Elements past the
+                ///     last group are left untouched.
+                /// </param>
+                /// <returns><c>true</c> if the regular expression finds a match; otherwise, <c>false</c>.</returns>
+                /// <remarks>
+                ///     No managed objects are allocated. Groups are only searched for if <paramref name="offsets"/> has room for
+                ///     them, so an array of two elements is the cheapest way to locate a match.
+                /// </remarks>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="offsets"/> has fewer than two elements.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="offsets"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.
+                /// </exception>
+                bool TryMatch(array<Byte>^ input, int startIndex, array<int>^ offsets);
+
+            #pragma endregion
+
+
+            #pragma region MatchOffsets
+
+            private:
+
+                int _matchOffsets(const StringPiece& haystack, int startIndex, int stringStartIndex, bool isUtf8, array<int>^ offsets, int% nextIndex);
+
+
+            public:
+
+                /// <summary>
+                ///     Searches the input string for successive occurrences of a regular expression, beginning at the specified starting
+                ///     position, and writes the position of each match and its groups into a caller-supplied array.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <param name="offsets">
+                ///     An array that receives, for each match, an (index, length) pair for the match followed by one pair for each group.
+                ///     Each match therefore takes up two elements, or two for every group plus two if <c>RegexOptions.SingleCapture</c> is
+                ///     not set. Groups that did not participate in a match are given an index of -1 and a length of 0.
+                /// </param>
+                /// <param name="nextIndex">
+                ///     When this method returns, the input index at which to resume the search, or -1 if the input has been exhausted.
+                /// </param>
+                /// <returns>The number of matches written to <paramref name="offsets"/>.</returns>
+                /// <remarks>
+                ///     <para>
+                ///         The whole search runs in a single call into native code, and the matches are the same as those that
+                ///         <see cref="Matches(String^, int)"/> would find. Searching stops early when <paramref name="offsets"/> is full.
+                ///     </para>
+                ///     <para>
+                ///         Each call converts <paramref name="input"/> afresh, so for long strings use an array that holds all expected
+                ///         matches, or search a byte array instead.
+                ///     </para>
+                /// </remarks>
+                /// <exception cref="System::ArgumentException">
+                ///     <para><paramref name="offsets"/> is too small to hold a single match.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="startIndex"/> bisects a UTF-16 surrogate pair.</para>
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="offsets"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                int MatchOffsets(String^ input, int startIndex, array<int>^ offsets, [Out] int% nextIndex);
+
+
+                /// <summary>
+                ///     Searches the input byte array for successive occurrences of a regular expression, beginning at the specified starting
+                ///     position, and writes the position of each match and its groups into a caller-supplied array.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <param name="offsets">
+                ///     An array that receives, for each match, an (index, length) pair for the match followed by one pair for each group.
+                ///     Each match therefore takes up two elements, or two for every group plus two if <c>RegexOptions.SingleCapture</c> is
+                ///     not set. Groups that did not participate in a match are given an index of -1 and a length of 0.
+                /// </param>
+                /// <param name="nextIndex">
+                ///     When this method returns, the input index at which to resume the search, or -1 if the input has been exhausted.
+                /// </param>
+                /// <returns>The number of matches written to <paramref name="offsets"/>.</returns>
+                /// <remarks>
+                ///     The whole search runs in a single call into native code, and the matches are the same as those that
+                ///     <see cref="Matches(array&lt;Byte&gt;^, int)"/> would find. Searching stops early when <paramref name="offsets"/> is full.
+                /// </remarks>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="offsets"/> is too small to hold a single match.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="offsets"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.
+                /// </exception>
+                int MatchOffsets(array<Byte>^ input, int startIndex, array<int>^ offsets, [Out] int% nextIndex);
+
+
+                /// <summary>
+                ///     Searches the input string for all occurrences of a regular expression, and writes the position of each match and
+                ///     its groups into a caller-supplied array.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="offsets">
+                ///     An array that receives, for each match, an (index, length) pair for the match followed by one pair for each group.
+                ///     Groups that did not participate in a match are given an index of -1 and a length of 0.
+                /// </param>
+                /// <returns>The number of matches written to <paramref name="offsets"/>.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="offsets"/> is too small to hold a single match.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="offsets"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                int MatchOffsets(String^ input, array<int>^ offsets);
+
+
+                /// <summary>
+                ///     Searches the input byte array for all occurrences of a regular expression, and writes the position of each match and
+                ///     its groups into a caller-supplied array.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="offsets">
+                ///     An array that receives, for each match, an (index, length) pair for the match followed by one pair for each group.
+                ///     Groups that did not participate in a match are given an index of -1 and a length of 0.
+                /// </param>
+                /// <returns>The number of matches written to <paramref name="offsets"/>.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="offsets"/> is too small to hold a single match.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="offsets"/> is <c>null</c>.
+                /// </exception>
+                int MatchOffsets(array<Byte>^ input, array<int>^ offsets);
+
+            #pragma endregion
+
+
+            #pragma region Match
+
+            internal:
+                
+                _Match^ _match(RegexInput^ input, Int64 startIndex, Int64 length, Int64 stringStartIndex, RegexAnchor anchor);
+
+                void _matchGroups(_Match^ match, array<Int64>^ offsets);
+
+                _Match^ _nextMatch(_Match^ match);
+
+                _Match^ _scan(const StringPiece& text, Int64 startpos, Int64 origin, CaptureBuffer^ captures);
+
+                CaptureBuffer^ _newCaptureBuffer();
+
+
+            public:
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of a regular expression, beginning at the specified starting
+                ///     position and searching only the specified number of characters.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <param name="length">The number of characters in the substring to include in the search.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="length"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><c><paramref name="startIndex"/> + <paramref name="length"/> - 1</c> identifies a position that is outside the range of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                _Match^ Match(String^ input, int startIndex, int length);
+                
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of a regular expression, beginning at the specified starting
+                ///     position and searching only the specified number of bytes.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <param name="length">The number of bytes in the input to include in the search.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="length"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><c><paramref name="startIndex"/> + <paramref name="length"/> - 1</c> identifies a position that is outside the range of <paramref name="input"/>.</para>
+                /// </exception>
+                _Match^ Match(array<Byte>^ input, int startIndex, int length);
+                
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of a regular expression, beginning at the specified starting
+                ///     position, searching only the specified number of characters, and anchoring the match as specified.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <param name="length">The number of characters in the substring to include in the search.</param>
+                /// <param name="anchor">
+                ///     Where the match must begin and end relative to the searched substring. <c>Match.NextMatch()</c> continues to search
+                ///     in the same way, so a <c>RegexAnchor.Start</c> match is followed only by matches that begin where it ended, and a
+                ///     <c>RegexAnchor.Both</c> match has no next match.
+                /// </param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="startIndex"/> bisects a UTF-16 surrogate pair.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="length"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><c><paramref name="startIndex"/> + <paramref name="length"/> - 1</c> identifies a position that is outside the range of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="anchor"/> is not a valid <c>RegexAnchor</c> value.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                _Match^ Match(String^ input, int startIndex, int length, RegexAnchor anchor);
+
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of a regular expression, beginning at the specified starting
+                ///     position, searching only the specified number of bytes, and anchoring the match as specified.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <param name="length">The number of bytes in the input to include in the search.</param>
+                /// <param name="anchor">
+                ///     Where the match must begin and end relative to the searched substring. <c>Match.NextMatch()</c> continues to search
+                ///     in the same way, so a <c>RegexAnchor.Start</c> match is followed only by matches that begin where it ended, and a
+                ///     <c>RegexAnchor.Both</c> match has no next match.
+                /// </param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="length"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><c><paramref name="startIndex"/> + <paramref name="length"/> - 1</c> identifies a position that is outside the range of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="anchor"/> is not a valid <c>RegexAnchor</c> value.</para>
+                /// </exception>
+                _Match^ Match(array<Byte>^ input, int startIndex, int length, RegexAnchor anchor);
+
+
+                /// <summary>
+                ///     Matches the regular expression at exactly the specified position in the input string.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="position">The input index at which the match must begin.</param>
+                /// <returns>
+                ///     An object that contains information about the match. The match is unsuccessful unless it begins at
+                ///     <paramref name="position"/>.
+                /// </returns>
+                /// <remarks>
+                ///     This is equivalent to <c>Match(input, position, input.Length - position, RegexAnchor.Start)</c>. Only the input
+                ///     at <paramref name="position"/> is examined, rather than every later position in turn.
+                /// </remarks>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="position"/> bisects a UTF-16 surrogate pair.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="position"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                _Match^ MatchAt(String^ input, int position);
+
+
+                /// <summary>
+                ///     Matches the regular expression at exactly the specified position in the input byte array.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="position">The input index at which the match must begin.</param>
+                /// <returns>
+                ///     An object that contains information about the match. The match is unsuccessful unless it begins at
+                ///     <paramref name="position"/>.
+                /// </returns>
+                /// <remarks>
+                ///     This is equivalent to <c>Match(input, position, input.Length - position, RegexAnchor.Start)</c>.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="position"/> is less than zero or greater than the length of <paramref name="input"/>.
+                /// </exception>
+                _Match^ MatchAt(array<Byte>^ input, int position);
+
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of a regular expression, beginning at the specified starting
+                ///     position in the string.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="startIndex">The zero-based input index at which to start the search.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                _Match^ Match(String^ input, int startIndex);
+                
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of a regular expression, beginning at the specified starting
+                ///     position.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.
+                /// </exception>
+                _Match^ Match(array<Byte>^ input, int startIndex);
+
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of a regular expression.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                _Match^ Match(String^ input);
+
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of a regular expression.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                _Match^ Match(array<Byte>^ input);
+
+
+                /// <summary>
+                ///     Searches the specified block of native memory for the first occurrence of a regular expression.
+                /// </summary>
+                /// <param name="data">A pointer to the bytes to search for a match.</param>
+                /// <param name="length">The number of bytes to search.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <remarks>
+                ///     The memory is searched in place, as a byte array would be, with no copy or pinning. The match and those that follow it
+                ///     are views over that memory: indices are byte offsets from <paramref name="data"/>, and values are decoded from the
+                ///     memory when they are read. The memory must stay valid for as long as the matches are used.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="data"/> is <c>IntPtr.Zero</c> and <paramref name="length"/> is greater than zero.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="length"/> is less than zero or greater than the address space of the process.
+                /// </exception>
+                _Match^ Match(IntPtr data, Int64 length);
+
+
+                /// <summary>
+                ///     Searches the specified block of native memory for the first occurrence of a regular expression, and calls back once
+                ///     the memory is no longer needed.
+                /// </summary>
+                /// <param name="data">A pointer to the bytes to search for a match.</param>
+                /// <param name="length">The number of bytes to search.</param>
+                /// <param name="release">
+                ///     Called exactly once, when no match refers to the memory any longer. It may be <c>null</c>.
+                /// </param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <remarks>
+                ///     <para>
+                ///         The memory is searched in place, as with <see cref="Match(IntPtr, Int64)"/>. If there is no match,
+                ///         <paramref name="release"/> is called before this method returns. Otherwise it is called when the last match found
+                ///         in the memory is disposed, or, for matches that are never disposed, from the finalizer thread.
+                ///     </para>
+                ///     <para>
+                ///         Once the memory has been released, reading a value that was not read earlier throws
+                ///         <see cref="System::ObjectDisposedException"/>.
+                ///     </para>
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="data"/> is <c>IntPtr.Zero</c> and <paramref name="length"/> is greater than zero.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="length"/> is less than zero or greater than the address space of the process.
+                /// </exception>
+                _Match^ Match(IntPtr data, Int64 length, Action^ release);
+
+
+                /// <summary>
+                ///     Searches the input char array for the first occurrence of a regular expression.
+                /// </summary>
+                /// <param name="input">The char array to search for a match.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <remarks>
+                ///     The array is transcoded directly, as a string would be, and indices are counted from its first char. Values are read
+                ///     back from the array when they're asked for, so it shouldn't be changed while the match is in use.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                _Match^ Match(array<Char>^ input);
+
+
+                /// <summary>
+                ///     Searches the input char array segment for the first occurrence of a regular expression.
+                /// </summary>
+                /// <param name="input">The char array segment to search for a match.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <remarks>
+                ///     The segment is transcoded directly, as a string would be, and indices are counted from its first char. Values are
+                ///     read back from the array when they're asked for, so it shouldn't be changed while the match is in use.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     The array of <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                _Match^ Match(ArraySegment<Char> input);
+
+
+                /// <summary>
+                ///     Searches the input string builder for the first occurrence of a regular expression.
+                /// </summary>
+                /// <param name="input">The string builder to search for a match.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <remarks>
+                ///     The builder is transcoded a block at a time, without first being converted to a string, and indices are the same as
+                ///     in the string it holds. Values are read back from the builder when they're asked for, so it shouldn't be changed
+                ///     while the match is in use.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                _Match^ Match(StringBuilder^ input);
+
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of the specified regular expression, using the specified matching options.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="options"/> is not a valid <c>RegexOptions</c> value.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                static _Match^ Match(String^ input, String^ pattern, RegexOptions options);
+
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of the specified regular expression, using the specified matching options.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="options"/> is not a valid <c>RegexOptions</c> value.
+                ///     <para>- or -</para>
+                ///     <para><paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                static _Match^ Match(array<Byte>^ input, String^ pattern, RegexOptions options);
+
+
+                /// <summary>
+                ///     Searches the input string for the first occurrence of the specified regular expression.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                static _Match^ Match(String^ input, String^ pattern);
+                /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
+
+
+                /// <summary>
+                ///     Searches the input byte array for the first occurrence of the specified regular expression.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <returns>An object that contains information about the match.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                static _Match^ Match(array<Byte>^ input, String^ pattern);
+                /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
+
+            #pragma endregion
+
+
+            #pragma region LastMatch
+
+            private:
+
+                _Match^ _lastMatch(RegexInput^ input, Int64 stringLength);
+
+
+            public:
+
+                /// <summary>
+                ///     Searches the input string for the last occurrence of a regular expression.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <returns>
+                ///     An object that contains information about the match that begins nearest the end of <paramref name="input"/>.
+                /// </returns>
+                /// <remarks>
+                ///     <para>
+                ///         The search works backwards from the end of the input in windows that double in size. Its cost therefore
+                ///         depends on how far the match is from the end, not on the length of <paramref name="input"/>.
+                ///     </para>
+                ///     <para>
+                ///         The match returned is the one that begins at the greatest index. It is the same match that
+                ///         <see cref="Match(String^, int)"/> finds when started at that index. It is not always the last item that
+                ///         <see cref="Matches(String^)"/> returns: <c>\d+</c> in <c>"56"</c> finds <c>"6"</c>, and <c>aa</c> in
+                ///         <c>"aaa"</c> finds the match at index 1, where <see cref="Matches(String^)"/> finds one at index 0.
+                ///     </para>
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                _Match^ LastMatch(String^ input);
+
+
+                /// <summary>
+                ///     Searches the input byte array for the last occurrence of a regular expression.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <returns>
+                ///     An object that contains information about the match that begins nearest the end of <paramref name="input"/>.
+                /// </returns>
+                /// <remarks>
+                ///     <para>
+                ///         The search works backwards from the end of the input in windows that double in size. Its cost therefore
+                ///         depends on how far the match is from the end, not on the length of <paramref name="input"/>.
+                ///     </para>
+                ///     <para>
+                ///         The match returned is the one that begins at the greatest index. It is the same match that
+                ///         <see cref="Match(array&lt;Byte&gt;^, int)"/> finds when started at that index. It is not always the last
+                ///         item that <see cref="Matches(array&lt;Byte&gt;^)"/> returns, since matches found from the start of the input
+                ///         may overlap it.
+                ///     </para>
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                _Match^ LastMatch(array<Byte>^ input);
+
+            #pragma endregion
+
+
+            #pragma region Matches
+
+                /// <summary>
+                ///     Searches the specified input string for all occurrences of a regular expression, beginning at the specified
+                ///     starting position in the string.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                MatchCollection^ Matches(String^ input, int startIndex);
+
+
+                /// <summary>
+                ///     Searches the specified input byte array for all occurrences of a regular expression, beginning at the specified
+                ///     starting position.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.
+                /// </exception>
+                MatchCollection^ Matches(array<Byte>^ input, int startIndex);
+
+
+                /// <summary>
+                ///     Searches the specified input string for all occurrences of a regular expression.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                MatchCollection^ Matches(String^ input);
+
+
+                /// <summary>
+                ///     Searches the specified input byte array for all occurrences of a regular expression.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                MatchCollection^ Matches(array<Byte>^ input);
+
+
+                /// <summary>
+                ///     Searches the specified block of native memory for all occurrences of a regular expression.
+                /// </summary>
+                /// <param name="data">A pointer to the bytes to search for a match.</param>
+                /// <param name="length">The number of bytes to search.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <remarks>
+                ///     The matches are views over the memory, which must stay valid for as long as they are used. See
+                ///     <see cref="Match(IntPtr, Int64)"/>.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="data"/> is <c>IntPtr.Zero</c> and <paramref name="length"/> is greater than zero.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="length"/> is less than zero or greater than the address space of the process.
+                /// </exception>
+                MatchCollection^ Matches(IntPtr data, Int64 length);
+
+
+                /// <summary>
+                ///     Searches the specified block of native memory for all occurrences of a regular expression, and calls back once the
+                ///     memory is no longer needed.
+                /// </summary>
+                /// <param name="data">A pointer to the bytes to search for a match.</param>
+                /// <param name="length">The number of bytes to search.</param>
+                /// <param name="release">
+                ///     Called exactly once, when no match refers to the memory any longer. It may be <c>null</c>.
+                /// </param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <remarks>
+                ///     Disposing the collection releases the memory. See <see cref="Match(IntPtr, Int64, Action)"/>.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="data"/> is <c>IntPtr.Zero</c> and <paramref name="length"/> is greater than zero.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="length"/> is less than zero or greater than the address space of the process.
+                /// </exception>
+                MatchCollection^ Matches(IntPtr data, Int64 length, Action^ release);
+
+
+                /// <summary>
+                ///     Searches the specified input char array for all occurrences of a regular expression.
+                /// </summary>
+                /// <param name="input">The char array to search for a match.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <remarks>
+                ///     See <see cref="Match(array&lt;Char&gt;^)"/>.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                MatchCollection^ Matches(array<Char>^ input);
+
+
+                /// <summary>
+                ///     Searches the specified input char array segment for all occurrences of a regular expression.
+                /// </summary>
+                /// <param name="input">The char array segment to search for a match.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <remarks>
+                ///     See <see cref="Match(ArraySegment&lt;Char&gt;)"/>.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     The array of <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                MatchCollection^ Matches(ArraySegment<Char> input);
+
+
+                /// <summary>
+                ///     Searches the specified input string builder for all occurrences of a regular expression.
+                /// </summary>
+                /// <param name="input">The string builder to search for a match.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <remarks>
+                ///     See <see cref="Match(StringBuilder^)"/>.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                MatchCollection^ Matches(StringBuilder^ input);
+
+
+                /// <summary>
+                ///     Searches the specified file for all occurrences of a regular expression.
+                /// </summary>
+                /// <param name="path">The file to search for a match.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <remarks>
+                ///     <para>
+                ///         The file is mapped into memory read-only and searched in place, as a byte array would be, without being read
+                ///         into one. Indices are file offsets; use <see cref="Capture::LongIndex"/> for files of 2 GB or more.
+                ///     </para>
+                ///     <para>
+                ///         The matches are views over the mapping, which stays open until the collection, or every match taken from it,
+                ///         is disposed. Other processes may go on writing to the file meanwhile, but bytes appended after the call aren't
+                ///         searched.
+                ///     </para>
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="path"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::IO::FileNotFoundException">
+                ///     The file specified by <paramref name="path"/> doesn't exist.
+                /// </exception>
+                /// <exception cref="System::IO::IOException">
+                ///     The file can't be opened or mapped.
+                /// </exception>
+                /// <exception cref="System::UnauthorizedAccessException">
+                ///     The caller doesn't have permission to read the file.
+                /// </exception>
+                MatchCollection^ MatchesInFile(String^ path);
+
+
+                /// <summary>
+                ///     Searches an input made up of the specified sequence of byte array segments for all occurrences of a regular
+                ///     expression, without copying the segments into one array.
+                /// </summary>
+                /// <param name="segments">The consecutive parts of the input, in order.</param>
+                /// <param name="maxMatchLength">The greatest number of bytes that a match can span.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <remarks>
+                ///     <para>
+                ///         Each segment is searched in place. Only matches that cross from one segment into the next are searched
+                ///         for in a copy, which holds no more than <c>2 * (<paramref name="maxMatchLength"/> + 2)</c> bytes, so
+                ///         the input is read once however it is split.
+                ///     </para>
+                ///     <para>
+                ///         Indices are counted from the start of the first segment. The matches hold copies of their own text and
+                ///         don't refer to the segments, which may be reused as soon as the method returns; as with
+                ///         <see cref="Match::Detach"/>, <see cref="Match::NextMatch"/> returns an unsuccessful match.
+                ///     </para>
+                ///     <para>
+                ///         A match longer than <paramref name="maxMatchLength"/> may be missed or cut short where it crosses from
+                ///         one segment into the next.
+                ///     </para>
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="segments"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentException">
+                ///     One of the <paramref name="segments"/> has no array.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="maxMatchLength"/> is less than 1 or greater than 1073741821.
+                /// </exception>
+                MatchCollection^ Matches(IEnumerable<ArraySegment<Byte>>^ segments, int maxMatchLength);
+
+
+                /// <summary>
+                ///     Searches the specified input string for all occurrences of the specified regular expression, using the
+                ///     specified matching options.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="options"/> is not a valid <c>RegexOptions</c> value.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                static MatchCollection^ Matches(String^ input, String^ pattern, RegexOptions options);
+
+
+                /// <summary>
+                ///     Searches the specified input byte array for all occurrences of the specified regular expression, using the
+                ///     specified matching options.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="options"/> is not a valid <c>RegexOptions</c> value.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                static MatchCollection^ Matches(array<Byte>^ input, String^ pattern, RegexOptions options);
+
+
+                /// <summary>
+                ///     Searches the specified input string for all occurrences of the specified regular expression.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                static MatchCollection^ Matches(String^ input, String^ pattern);
+                /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
+
+
+                /// <summary>
+                ///     Searches the specified input byte array for all occurrences of the specified regular expression.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <returns>
+                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
+                ///     returns an empty collection object.
+                /// </returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                static MatchCollection^ Matches(array<Byte>^ input, String^ pattern);
+                /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
+
+            #pragma endregion
+
+
+            #pragma region MatchesAsync
+
+                /// <summary>
+                ///     Asynchronously searches the specified stream for all occurrences of a regular expression.
+                /// </summary>
+                /// <param name="input">The stream to search for a match, which is read from its current position to its end.</param>
+                /// <param name="bufferSize">The number of bytes to read from <paramref name="input"/> at a time.</param>
+                /// <param name="maxMatchLength">The greatest number of bytes that a match can span.</param>
+                /// <returns>
+                ///     A task whose result is a collection of the <see cref="Re2::Net::Match"/> objects found by the search.
+                /// </returns>
+                /// <remarks>
+                ///     <para>
+                ///         The stream is read into two buffers of <paramref name="bufferSize"/> bytes in turn, and the next one is read
+                ///         while the last is searched. Matches that cross from one read into the next are found as by
+                ///         <see cref="Matches(IEnumerable&lt;ArraySegment&lt;Byte&gt;&gt;^, int)"/>, which describes the part that
+                ///         <paramref name="maxMatchLength"/> plays.
+                ///     </para>
+                ///     <para>
+                ///         Indices are offsets from the position at which reading began. The matches hold copies of their own text.
+                ///         Errors from the stream, and cancellation of its reads, are passed on to the task.
+                ///     </para>
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="input"/> doesn't support reading.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="bufferSize"/> is less than 1.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="maxMatchLength"/> is less than 1 or greater than 1073741821.</para>
+                /// </exception>
+                Task<MatchCollection^>^ MatchesAsync(Stream^ input, int bufferSize, int maxMatchLength);
+
+
+                /// <summary>
+                ///     Asynchronously searches the specified stream for all occurrences of a regular expression, passing each to the
+                ///     specified callback as soon as it's found.
+                /// </summary>
+                /// <param name="input">The stream to search for a match, which is read from its current position to its end.</param>
+                /// <param name="bufferSize">The number of bytes to read from <paramref name="input"/> at a time.</param>
+                /// <param name="maxMatchLength">The greatest number of bytes that a match can span.</param>
+                /// <param name="match">Called with each match, in order, on a thread pool thread.</param>
+                /// <returns>A task whose result is the number of matches found.</returns>
+                /// <remarks>
+                ///     As <see cref="MatchesAsync(Stream^, int, int)"/>, but no match is kept once <paramref name="match"/> has returned,
+                ///     so that a stream of any length is searched in memory bounded by the two buffers. An exception thrown by
+                ///     <paramref name="match"/> ends the search and is passed on to the task.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="match"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="input"/> doesn't support reading.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="bufferSize"/> is less than 1.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="maxMatchLength"/> is less than 1 or greater than 1073741821.</para>
+                /// </exception>
+                Task<Int64>^ MatchesAsync(Stream^ input, int bufferSize, int maxMatchLength, Action<_Match^>^ match);
+
+            #pragma endregion
+
+
+            #pragma region EnumerateMatches
+
+                /// <summary>
+                ///     Lazily searches the specified input string for all occurrences of a regular expression, beginning at the
+                ///     specified starting position in the string.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <returns>
+                ///     A sequence of the <see cref="Re2::Net::Match"/> objects found by the search, which are found one at a time as the
+                ///     sequence is enumerated.
+                /// </returns>
+                /// <remarks>
+                ///     Unlike the collection returned by <c>Matches()</c>, the sequence doesn't keep the matches it has produced, so
+                ///     enumerating it takes the same memory however many matches there are. Each enumeration searches the input again.
+                ///     Each match may be disposed as soon as it has been used. Every enumeration begins with the same first match,
+                ///     though, so once that match has been disposed the sequence can't be enumerated again, and doing so throws
+                ///     <see cref="System::InvalidOperationException"/>.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                IEnumerable<_Match^>^ EnumerateMatches(String^ input, int startIndex);
+
+
+                /// <summary>
+                ///     Lazily searches the specified input byte array for all occurrences of a regular expression, beginning at the
+                ///     specified starting position.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <returns>
+                ///     A sequence of the <see cref="Re2::Net::Match"/> objects found by the search, which are found one at a time as the
+                ///     sequence is enumerated.
+                /// </returns>
+                /// <remarks>
+                ///     Unlike the collection returned by <c>Matches()</c>, the sequence doesn't keep the matches it has produced, so
+                ///     enumerating it takes the same memory however many matches there are. Each enumeration searches the input again.
+                ///     Each match may be disposed as soon as it has been used. Every enumeration begins with the same first match,
+                ///     though, so once that match has been disposed the sequence can't be enumerated again, and doing so throws
+                ///     <see cref="System::InvalidOperationException"/>.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> is <c>null</c>.
                 /// </exception>
                 /// <exception cref="System::ArgumentOutOfRangeException">
                 ///     <paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.
                 /// </exception>
-                MatchCollection^ Matches(array<Byte>^ input, int startIndex);
+                IEnumerable<_Match^>^ EnumerateMatches(array<Byte>^ input, int startIndex);
 
 
                 /// <summary>
-                ///     Searches the specified input string for all occurrences of a regular expression.
+                ///     Lazily searches the specified input string for all occurrences of a regular expression.
                 /// </summary>
                 /// <param name="input">The string to search for a match.</param>
                 /// <returns>
-                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
-                ///     returns an empty collection object.
+                ///     A sequence of the <see cref="Re2::Net::Match"/> objects found by the search, which are found one at a time as the
+                ///     sequence is enumerated.
                 /// </returns>
+                /// <remarks>
+                ///     Unlike the collection returned by <c>Matches()</c>, the sequence doesn't keep the matches it has produced, so
+                ///     enumerating it takes the same memory however many matches there are. Each enumeration searches the input again.
+                ///     Each match may be disposed as soon as it has been used. Every enumeration begins with the same first match,
+                ///     though, so once that match has been disposed the sequence can't be enumerated again, and doing so throws
+                ///     <see cref="System::InvalidOperationException"/>.
+                /// </remarks>
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> is <c>null</c>.
                 /// </exception>
@@ -718,25 +2006,32 @@ namespace Net
                 ///     <para>- or -</para>
                 ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
-                MatchCollection^ Matches(String^ input);
+                IEnumerable<_Match^>^ EnumerateMatches(String^ input);
 
 
                 /// <summary>
-                ///     Searches the specified input byte array for all occurrences of a regular expression.
+                ///     Lazily searches the specified input byte array for all occurrences of a regular expression.
                 /// </summary>
                 /// <param name="input">The byte array to search for a match.</param>
                 /// <returns>
-                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
-                ///     returns an empty collection object.
+                ///     A sequence of the <see cref="Re2::Net::Match"/> objects found by the search, which are found one at a time as the
+                ///     sequence is enumerated.
                 /// </returns>
+                /// <remarks>
+                ///     Unlike the collection returned by <c>Matches()</c>, the sequence doesn't keep the matches it has produced, so
+                ///     enumerating it takes the same memory however many matches there are. Each enumeration searches the input again.
+                ///     Each match may be disposed as soon as it has been used. Every enumeration begins with the same first match,
+                ///     though, so once that match has been disposed the sequence can't be enumerated again, and doing so throws
+                ///     <see cref="System::InvalidOperationException"/>.
+                /// </remarks>
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> is <c>null</c>.
                 /// </exception>
-                MatchCollection^ Matches(array<Byte>^ input);
+                IEnumerable<_Match^>^ EnumerateMatches(array<Byte>^ input);
 
 
                 /// <summary>
-                ///     Searches the specified input string for all occurrences of the specified regular expression, using the
+                ///     Lazily searches the specified input string for all occurrences of the specified regular expression, using the
                 ///     specified matching options.
                 /// </summary>
                 /// <param name="input">The string to search for a match.</param>
@@ -746,8 +2041,8 @@ namespace Net
                 /// </param>
                 /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
                 /// <returns>
-                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
-                ///     returns an empty collection object.
+                ///     A sequence of the <see cref="Re2::Net::Match"/> objects found by the search, which are found one at a time as the
+                ///     sequence is enumerated.
                 /// </returns>
                 /// <exception cref="System::ArgumentException">
                 ///     A regular expression parsing error occurred.
@@ -762,12 +2057,12 @@ namespace Net
                 ///     <para>- or -</para>
                 ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
-                static MatchCollection^ Matches(String^ input, String^ pattern, RegexOptions options);
+                static IEnumerable<_Match^>^ EnumerateMatches(String^ input, String^ pattern, RegexOptions options);
 
 
                 /// <summary>
-                ///     Searches the specified input byte array for all occurrences of the specified regular expression, using the
-                ///     specified matching options.
+                ///     Lazily searches the specified input byte array for all occurrences of the specified regular expression, using
+                ///     the specified matching options.
                 /// </summary>
                 /// <param name="input">The byte array to search for a match.</param>
                 /// <param name="pattern">
@@ -776,8 +2071,8 @@ namespace Net
                 /// </param>
                 /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
                 /// <returns>
-                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
-                ///     returns an empty collection object.
+                ///     A sequence of the <see cref="Re2::Net::Match"/> objects found by the search, which are found one at a time as the
+                ///     sequence is enumerated.
                 /// </returns>
                 /// <exception cref="System::ArgumentException">
                 ///     A regular expression parsing error occurred.
@@ -792,11 +2087,11 @@ namespace Net
                 ///     <para>- or -</para>
                 ///     <para><paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
                 /// </exception>
-                static MatchCollection^ Matches(array<Byte>^ input, String^ pattern, RegexOptions options);
+                static IEnumerable<_Match^>^ EnumerateMatches(array<Byte>^ input, String^ pattern, RegexOptions options);
 
 
                 /// <summary>
-                ///     Searches the specified input string for all occurrences of the specified regular expression.
+                ///     Lazily searches the specified input string for all occurrences of the specified regular expression.
                 /// </summary>
                 /// <param name="input">The string to search for a match.</param>
                 /// <param name="pattern">
@@ -804,8 +2099,8 @@ namespace Net
                 ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
                 /// </param>
                 /// <returns>
-                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
-                ///     returns an empty collection object.
+                ///     A sequence of the <see cref="Re2::Net::Match"/> objects found by the search, which are found one at a time as the
+                ///     sequence is enumerated.
                 /// </returns>
                 /// <exception cref="System::ArgumentException">
                 ///     A regular expression parsing error occurred.
@@ -813,12 +2108,12 @@ namespace Net
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
                 /// </exception>
-                static MatchCollection^ Matches(String^ input, String^ pattern);
+                static IEnumerable<_Match^>^ EnumerateMatches(String^ input, String^ pattern);
                 /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
 
 
                 /// <summary>
-                ///     Searches the specified input byte array for all occurrences of the specified regular expression.
+                ///     Lazily searches the specified input byte array for all occurrences of the specified regular expression.
                 /// </summary>
                 /// <param name="input">The byte array to search for a match.</param>
                 /// <param name="pattern">
@@ -826,8 +2121,8 @@ namespace Net
                 ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
                 /// </param>
                 /// <returns>
-                ///     A collection of the <see cref="Re2::Net::Match"/> objects found by the search. If no matches are found, the method
-                ///     returns an empty collection object.
+                ///     A sequence of the <see cref="Re2::Net::Match"/> objects found by the search, which are found one at a time as the
+                ///     sequence is enumerated.
                 /// </returns>
                 /// <exception cref="System::ArgumentException">
                 ///     A regular expression parsing error occurred.
@@ -835,11 +2130,366 @@ namespace Net
                 /// <exception cref="System::ArgumentNullException">
                 ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
                 /// </exception>
-                static MatchCollection^ Matches(array<Byte>^ input, String^ pattern);
+                static IEnumerable<_Match^>^ EnumerateMatches(array<Byte>^ input, String^ pattern);
+                /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
+
+            #pragma endregion
+
+
+            #pragma region Count
+
+            private:
+
+                int _count(const StringPiece& haystack, int startIndex, int length, bool isUtf8);
+
+
+            public:
+
+                /// <summary>
+                ///     Searches the specified portion of the input string for all occurrences of a regular expression, and returns the
+                ///     number of matches found.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <param name="length">The number of characters to include in the search.</param>
+                /// <returns>The number of matches found.</returns>
+                /// <remarks>
+                ///     The result is always equal to the <c>Count</c> of the collection returned by <see cref="Matches(String^)"/>
+                ///     (empty matches included), but no <see cref="Re2::Net::Match"/> objects are created along the way.
+                /// </remarks>
+                /// <exception cref="System::ArgumentException">
+                ///     <paramref name="startIndex"/> bisects a UTF-16 surrogate pair.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="length"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="startIndex"/> + <paramref name="length"/> is greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                int Count(String^ input, int startIndex, int length);
+
+
+                /// <summary>
+                ///     Searches the specified portion of the input byte array for all occurrences of a regular expression, and returns
+                ///     the number of matches found.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="startIndex">The input index at which to start the search.</param>
+                /// <param name="length">The number of bytes to include in the search.</param>
+                /// <returns>The number of matches found.</returns>
+                /// <remarks>
+                ///     The result is always equal to the <c>Count</c> of the collection returned by <see cref="Matches(array&lt;Byte&gt;^)"/>
+                ///     (empty matches included), but no <see cref="Re2::Net::Match"/> objects are created along the way.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="startIndex"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="length"/> is less than zero or greater than the length of <paramref name="input"/>.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="startIndex"/> + <paramref name="length"/> is greater than the length of <paramref name="input"/>.</para>
+                /// </exception>
+                int Count(array<Byte>^ input, int startIndex, int length);
+
+
+                /// <summary>
+                ///     Searches the input string for all occurrences of a regular expression, and returns the number of matches found.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <returns>The number of matches found.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                int Count(String^ input);
+
+
+                /// <summary>
+                ///     Searches the input byte array for all occurrences of a regular expression, and returns the number of matches found.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <returns>The number of matches found.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                int Count(array<Byte>^ input);
+
+
+                /// <summary>
+                ///     Searches the specified input string for all occurrences of the specified regular expression, using the
+                ///     specified matching options, and returns the number of matches found.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
+                /// <returns>The number of matches found.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="options"/> is not a valid <c>RegexOptions</c> value.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> or <paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                static int Count(String^ input, String^ pattern, RegexOptions options);
+
+
+                /// <summary>
+                ///     Searches the specified input byte array for all occurrences of the specified regular expression, using the
+                ///     specified matching options, and returns the number of matches found.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <param name="options">A bitwise combination of the enumeration values that specify options for matching.</param>
+                /// <returns>The number of matches found.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="options"/> is not a valid <c>RegexOptions</c> value.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="pattern"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="pattern"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                static int Count(array<Byte>^ input, String^ pattern, RegexOptions options);
+
+
+                /// <summary>
+                ///     Searches the specified input string for all occurrences of the specified regular expression, and returns the
+                ///     number of matches found.
+                /// </summary>
+                /// <param name="input">The string to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <returns>The number of matches found.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                static int Count(String^ input, String^ pattern);
+                /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
+
+
+                /// <summary>
+                ///     Searches the specified input byte array for all occurrences of the specified regular expression, and returns the
+                ///     number of matches found.
+                /// </summary>
+                /// <param name="input">The byte array to search for a match.</param>
+                /// <param name="pattern">
+                ///     The regular expression pattern to match. See <a href="http://code.google.com/p/re2/wiki/Syntax">
+                ///     http://code.google.com/p/re2/wiki/Syntax</a> for the list of regular expression syntax accepted by Re2.Net.
+                /// </param>
+                /// <returns>The number of matches found.</returns>
+                /// <exception cref="System::ArgumentException">
+                ///     A regular expression parsing error occurred.
+                /// </exception>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="pattern"/> is <c>null</c>.
+                /// </exception>
+                static int Count(array<Byte>^ input, String^ pattern);
                 /* ArgumentOutOfRangeExceptions for encoding can't be thrown if no RegexOptions are provided. */
 
             #pragma endregion
 
+
+            #pragma region MatchLines
+
+            private:
+
+                int _matchLines(const StringPiece& haystack, bool isUtf8, bool invert, array<int>^ lines, int capacity);
+
+
+            public:
+
+                /// <summary>
+                ///     Searches each line of the specified input string for the regular expression, and reports the lines that match, or
+                ///     that don't.
+                /// </summary>
+                /// <param name="input">The string to search.</param>
+                /// <param name="lines">The array to write a (line number, index, length) triple to for each line found.</param>
+                /// <param name="invert"><c>true</c> to report the lines that don't match instead.</param>
+                /// <returns>The number of lines written to <paramref name="lines"/>.</returns>
+                /// <remarks>
+                ///     <para>
+                ///         Lines end at each <c>'\n'</c>, which isn't part of the line, and a final <c>'\n'</c> doesn't begin another
+                ///         one. Each line is searched on its own, so <c>^</c> and <c>$</c> match at its ends whatever the options.
+                ///     </para>
+                ///     <para>
+                ///         Each line found is written to <paramref name="lines"/> as three values: its line number, counting from 1,
+                ///         and the String index and length of its text. Searching stops when <paramref name="lines"/> is full, so its
+                ///         length sets the most lines that are reported. No <see cref="Re2::Net::Match"/> objects are created.
+                ///     </para>
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="lines"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                int MatchLines(String^ input, array<int>^ lines, bool invert);
+
+
+                /// <summary>
+                ///     Searches each line of the specified input byte array for the regular expression, and reports the lines that match,
+                ///     or that don't.
+                /// </summary>
+                /// <param name="input">The byte array to search.</param>
+                /// <param name="lines">The array to write a (line number, index, length) triple to for each line found.</param>
+                /// <param name="invert"><c>true</c> to report the lines that don't match instead.</param>
+                /// <returns>The number of lines written to <paramref name="lines"/>.</returns>
+                /// <remarks>
+                ///     As <see cref="MatchLines(String^, array&lt;int&gt;^, bool)"/>, with byte indices and lengths.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="lines"/> is <c>null</c>.
+                /// </exception>
+                int MatchLines(array<Byte>^ input, array<int>^ lines, bool invert);
+
+
+                /// <summary>
+                ///     Searches each line of the specified input string for the regular expression, and reports the lines that match.
+                /// </summary>
+                /// <param name="input">The string to search.</param>
+                /// <param name="lines">The array to write a (line number, index, length) triple to for each line found.</param>
+                /// <returns>The number of lines written to <paramref name="lines"/>.</returns>
+                /// <remarks>
+                ///     See <see cref="MatchLines(String^, array&lt;int&gt;^, bool)"/>.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="lines"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                int MatchLines(String^ input, array<int>^ lines);
+
+
+                /// <summary>
+                ///     Searches each line of the specified input byte array for the regular expression, and reports the lines that match.
+                /// </summary>
+                /// <param name="input">The byte array to search.</param>
+                /// <param name="lines">The array to write a (line number, index, length) triple to for each line found.</param>
+                /// <returns>The number of lines written to <paramref name="lines"/>.</returns>
+                /// <remarks>
+                ///     See <see cref="MatchLines(String^, array&lt;int&gt;^, bool)"/>.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> or <paramref name="lines"/> is <c>null</c>.
+                /// </exception>
+                int MatchLines(array<Byte>^ input, array<int>^ lines);
+
+
+                /// <summary>
+                ///     Searches each line of the specified input string for the regular expression, and returns the number of lines that
+                ///     match, or that don't.
+                /// </summary>
+                /// <param name="input">The string to search.</param>
+                /// <param name="invert"><c>true</c> to count the lines that don't match instead.</param>
+                /// <param name="maxCount">The number of lines at which to stop counting.</param>
+                /// <returns>The number of lines found.</returns>
+                /// <remarks>
+                ///     Lines are found as by <see cref="MatchLines(String^, array&lt;int&gt;^, bool)"/>, but only counted.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="maxCount"/> is less than zero.</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                int CountLines(String^ input, bool invert, int maxCount);
+
+
+                /// <summary>
+                ///     Searches each line of the specified input byte array for the regular expression, and returns the number of lines
+                ///     that match, or that don't.
+                /// </summary>
+                /// <param name="input">The byte array to search.</param>
+                /// <param name="invert"><c>true</c> to count the lines that don't match instead.</param>
+                /// <param name="maxCount">The number of lines at which to stop counting.</param>
+                /// <returns>The number of lines found.</returns>
+                /// <remarks>
+                ///     Lines are found as by <see cref="MatchLines(array&lt;Byte&gt;^, array&lt;int&gt;^, bool)"/>, but only counted.
+                /// </remarks>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <paramref name="maxCount"/> is less than zero.
+                /// </exception>
+                int CountLines(array<Byte>^ input, bool invert, int maxCount);
+
+
+                /// <summary>
+                ///     Searches each line of the specified input string for the regular expression, and returns the number of lines that
+                ///     match.
+                /// </summary>
+                /// <param name="input">The string to search.</param>
+                /// <returns>The number of lines found.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                /// <exception cref="System::ArgumentOutOfRangeException">
+                ///     <para><paramref name="input"/> is not a valid Latin-1 string (flag <c>RegexOptions.Latin1</c> is set).</para>
+                ///     <para>- or -</para>
+                ///     <para><paramref name="input"/> is not a valid ASCII string (flag <c>RegexOptions.ASCII</c> is set).</para>
+                /// </exception>
+                int CountLines(String^ input);
+
+
+                /// <summary>
+                ///     Searches each line of the specified input byte array for the regular expression, and returns the number of lines
+                ///     that match.
+                /// </summary>
+                /// <param name="input">The byte array to search.</param>
+                /// <returns>The number of lines found.</returns>
+                /// <exception cref="System::ArgumentNullException">
+                ///     <paramref name="input"/> is <c>null</c>.
+                /// </exception>
+                int CountLines(array<Byte>^ input);
+
+            #pragma endregion
+
         #pragma endregion
 
 
@@ -0,0 +1,42 @@
+﻿/*
+ *  Re2.Net Copyright ©2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+
+namespace Re2
+{
+namespace Net
+{
+    /*
+     *  The values mirror RE2::Anchor, so a RegexAnchor can be cast straight to
+     *  the native enum.
+     */
+
+    /// <summary>
+    ///     Specifies where a match must begin and end relative to the searched portion of the input.
+    /// </summary>
+    public enum class RegexAnchor
+    {
+        /// <summary>
+        ///     The match can begin and end anywhere in the searched portion of the input.
+        /// </summary>
+        None = 0,
+
+        /// <summary>
+        ///     The match must begin at the start of the searched portion of the input. This is equivalent to
+        ///     beginning the pattern with '\G' in .NET, and is far cheaper than an unanchored search.
+        /// </summary>
+        Start = 1,
+
+        /// <summary>
+        ///     The match must span the whole of the searched portion of the input. This is the cheapest way to
+        ///     validate input, and is cheaper than wrapping the pattern in '^' and '$'.
+        /// </summary>
+        Both = 2
+    };
+}
+}
@@ -11,12 +11,70 @@
     #include <malloc.h>
 #pragma managed(pop)
 
+#include "BufferPool.h"
+
 namespace Re2
 {
 namespace Net
 {
     using namespace System;
     using namespace System::Runtime::InteropServices;
+    using namespace System::Threading;
+
+    using System::Text::StringBuilder;
+
+
+    /*
+     *  Owns the native side of a RegexInput: a block from BufferPool, or caller memory together with
+     *  the callback that gives it back. RegexInput releases it as soon as the last Match that can
+     *  search the input is disposed. Matches that are never disposed leave the release to SafeHandle's
+     *  critical finalizer, which is the only finalizer left on the input path.
+     */
+    private ref class RegexInputHandle : public SafeHandle
+    {
+        private:
+
+            initonly Action^ _release;
+
+
+        internal:
+
+            RegexInputHandle(IntPtr handle)
+                : SafeHandle(IntPtr::Zero, true),
+                  _release(nullptr)
+            {
+                this->SetHandle(handle);
+            }
+
+            RegexInputHandle(IntPtr handle, Action^ release)
+                : SafeHandle(IntPtr::Zero, true),
+                  _release(release)
+            {
+                this->SetHandle(handle);
+            }
+
+
+        public:
+
+            /* Caller memory may legitimately be empty at address zero, but its callback must still run. */
+            virtual property bool IsInvalid
+            {
+                bool get() override { return !_release && IntPtr::Zero == this->handle; }
+            }
+
+
+        protected:
+
+            virtual bool ReleaseHandle() override
+            {
+                if(_release)
+                    _release();
+                else
+                    BufferPool::Return(static_cast<char*>(this->handle.ToPointer()));
+
+                return true;
+            }
+    };
 
 
     /*
@@ -33,29 +91,57 @@ namespace Net
     {
         private:
             
-            initonly String^      _input;
-            initonly array<Byte>^ _bytes;
-            initonly const char*  _data;
-            initonly int          _length;
-            initonly GCHandle^    _handle;
-            initonly bool         _isUtf8;
+            initonly String^           _input;
+            initonly array<Char>^      _chars;
+            initonly int               _charStart;
+            initonly StringBuilder^    _builder;
+            initonly array<Byte>^      _bytes;
+            initonly const char*       _data;
+            initonly Int64             _length;
+            initonly RegexInputHandle^ _handle;
+            initonly bool              _isUtf8;
+            initonly Int64             _origin;
+            initonly bool              _pinPerCall;
+            initonly bool              _external;
+
+            /* The number of live Matches that refer to the input, or -1 once its native side is released. */
+            int _references;
 
 
         internal:
 
             /*
              *  If the RegexInput is created from an unmanaged char array, it assumes
-             *  ownership of the array and deletes it in the dtor.
+             *  ownership of the array, which must come from BufferPool::Rent(), and
+             *  returns it to the pool on release.
              *
              *  If the RegexInput is created from a managed Byte array, the array is
-             *  pinned in memory via GCHandle, which the dtor frees.
+             *  either copied into a pooled block, or left unpinned and pinned by each
+             *  search for its own duration; see Regex::ByteCopyThreshold. In the second
+             *  case Data is NULL and the searches pin Bytes themselves.
+             *
+             *  Each Match that refers to the input calls AddReference(), and Release()
+             *  when it's disposed; the last Release() frees the native side at once.
+             *  The dtor does the same for an input that no Match refers to.
              *
              *  NB: The point of accepting Byte arrays is that no additional processing
-             *      (e.g. UTF-16 -> UTF-8 conversion) or duplication of data is necessary.
-             *      It seems natural that Strings, which are immutable by their nature,
-             *      are copied, while Byte arrays, which can be edited in-place, are not.
-             *      Still I'm open to the idea of modifying the Regex::Match() methods to
-             *      create copies of Byte arrays, which obviates the need for GCHandle.
+             *      (e.g. UTF-16 -> UTF-8 conversion) is necessary. Small arrays are copied
+             *      anyway, because a long-lived pin on each of them fragments the GC heap
+             *      far more than the copy costs. Values are still read from Bytes, so a
+             *      copied array that is edited in-place can disagree with later searches.
+             *
+             *  If the RegexInput is created from caller memory, the memory is searched in
+             *  place and read like a Byte array, through Data. The optional release
+             *  callback is invoked on release.
+             *
+             *  If the RegexInput is created from a char array or a StringBuilder, it's
+             *  searched like a String, and values are read back from the array or the
+             *  builder rather than from a String made of all of it. Like Byte arrays,
+             *  they are read as they are when the value is asked for.
+             *
+             *  A detached RegexInput (see Match::Detach()) holds only the text of a single match, which
+             *  begins at index _origin of the original input. It has no native data, because the match's
+             *  groups have already been found and it can't be searched again.
              */
 
             static RegexInput^ Empty = gcnew RegexInput(String::Empty, nullptr, 0, false);
@@ -66,18 +152,114 @@ namespace Net
                   _length(length),
                   _isUtf8(isUtf8),
                   _bytes(nullptr),
-                  _handle(nullptr)
+                  _handle(data ? gcnew RegexInputHandle(IntPtr(const_cast<char*>(data))) : nullptr),
+                  _origin(0),
+                  _pinPerCall(false),
+                  _external(false),
+                  _references(0)
+            {
+            }
+
+            RegexInput(ArraySegment<Char> chars, const char* data, int length, bool isUtf8)
+                : _input(String::Empty),
+                  _chars(chars.Array),
+                  _charStart(chars.Offset),
+                  _data(data),
+                  _length(length),
+                  _isUtf8(isUtf8),
+                  _bytes(nullptr),
+                  _handle(data ? gcnew RegexInputHandle(IntPtr(const_cast<char*>(data))) : nullptr),
+                  _origin(0),
+                  _pinPerCall(false),
+                  _external(false),
+                  _references(0)
+            {
+            }
+
+            RegexInput(StringBuilder^ builder, const char* data, int length, bool isUtf8)
+                : _input(String::Empty),
+                  _builder(builder),
+                  _data(data),
+                  _length(length),
+                  _isUtf8(isUtf8),
+                  _bytes(nullptr),
+                  _handle(data ? gcnew RegexInputHandle(IntPtr(const_cast<char*>(data))) : nullptr),
+                  _origin(0),
+                  _pinPerCall(false),
+                  _external(false),
+                  _references(0)
+            {
+            }
+
+            RegexInput(String^ input, bool isUtf8, Int64 origin)
+                : _input(input),
+                  _data(nullptr),
+                  _length(0),
+                  _isUtf8(isUtf8),
+                  _bytes(nullptr),
+                  _handle(nullptr),
+                  _origin(origin),
+                  _pinPerCall(false),
+                  _external(false),
+                  _references(0)
+            {
+            }
+
+            RegexInput(array<Byte>^ bytes, bool isUtf8, Int64 origin)
+                : _input(String::Empty),
+                  _data(nullptr),
+                  _length(0),
+                  _isUtf8(isUtf8),
+                  _bytes(bytes),
+                  _handle(nullptr),
+                  _origin(origin),
+                  _pinPerCall(false),
+                  _external(false),
+                  _references(0)
             {
             }
                     
-            RegexInput(array<Byte>^ bytes, bool isUtf8)
+            RegexInput(array<Byte>^ bytes, bool isUtf8, bool copy)
+            {
+                _bytes      = bytes;
+                _length     = bytes->Length;
+                _isUtf8     = isUtf8;
+                _input      = String::Empty;
+                _origin     = 0;
+                _references = 0;
+                _pinPerCall = !copy;
+                _external   = false;
+
+                if(copy)
+                {
+                    char* data = BufferPool::Rent(bytes->Length);
+                    if(!data)
+                        throw gcnew OutOfMemoryException();
+                    if(_length)
+                        Marshal::Copy(bytes, 0, IntPtr(data), bytes->Length);
+
+                    _data   = data;
+                    _handle = gcnew RegexInputHandle(IntPtr(data));
+                }
+                else
+                {
+                    _data   = nullptr;
+                    _handle = nullptr;
+                }
+            }
+            
+            RegexInput(IntPtr data, Int64 length, bool isUtf8, Action^ release)
+                : _input(String::Empty),
+                  _data(static_cast<const char*>(data.ToPointer())),
+                  _length(length),
+                  _isUtf8(isUtf8),
+                  _bytes(nullptr),
+                  _handle(release ? gcnew RegexInputHandle(data, release) : nullptr),
+                  _origin(0),
+                  _pinPerCall(false),
+                  _external(true),
+                  _references(0)
             {
-                _bytes  = bytes;
-                _handle = GCHandle::Alloc(bytes, GCHandleType::Pinned);
-                _length = bytes->Length;
-                _data   = (const char*)_handle->AddrOfPinnedObject().ToPointer();
-                _isUtf8 = isUtf8;
-                _input  = String::Empty;
             }
             
             property String^ Input
@@ -85,19 +267,42 @@ namespace Net
                 String^ get() { return _input; }
             }
 
+            /* The char array of a char array input, whose first char is CharStart; otherwise null. */
+            property array<Char>^ Chars
+            {
+                array<Char>^ get() { return _chars; }
+            }
+
+            property int CharStart
+            {
+                int get() { return _charStart; }
+            }
+
+            /* The builder of a StringBuilder input; otherwise null. */
+            property StringBuilder^ Builder
+            {
+                StringBuilder^ get() { return _builder; }
+            }
+
             property array<Byte>^ Bytes
             {
                 array<Byte>^ get() { return _bytes; }
             }
 
+            /* Throws ObjectDisposedException once the native side has been released. */
             property const char* Data
             {
-                const char* get() { return _data; }
+                const char* get()
+                {
+                    if(_handle && _handle->IsClosed)
+                        throw gcnew ObjectDisposedException("Match", "The input of a disposed Match cannot be searched.");
+                    return _data;
+                }
             }
 
-            property int Length
+            property Int64 Length
             {
-                int get() { return _length; }
+                Int64 get() { return _length; }
             }
 
             property bool IsUTF8
@@ -105,20 +310,66 @@ namespace Net
                 bool get() { return _isUtf8; }
             }
 
-            ~RegexInput()
+            property Int64 Origin
             {
-                this->!RegexInput();
+                Int64 get() { return _origin; }
             }
-        
-    
-        protected:
-            
-            !RegexInput()
+
+            /* True if the input is read as bytes, from Bytes or from caller memory, rather than from a String. */
+            property bool IsByteInput
             {
-                if(_handle)
-                    _handle->Free();
+                bool get() { return _bytes || _external; }
+            }
+
+            /* True if the input is an uncopied Byte array, which each search has to pin itself. */
+            property bool PinPerCall
+            {
+                bool get() { return _pinPerCall; }
+            }
+
+            /* Returns length chars of a text input from index, whichever of String, char array or builder holds them. */
+            String^ Substring(int index, int length)
+            {
+                if(_chars)
+                    return gcnew String(_chars, _charStart + index, length);
+                if(_builder)
+                    return _builder->ToString(index, length);
+                return _input->Substring(index, length);
+            }
+
+            void CopyChars(int index, array<Char>^ destination, int destinationIndex, int length)
+            {
+                if(_chars)
+                    Array::Copy(_chars, _charStart + index, destination, destinationIndex, length);
+                else if(_builder)
+                    _builder->CopyTo(index, destination, destinationIndex, length);
                 else
-                    free(const_cast<char*>(_data));
+                    _input->CopyTo(index, destination, destinationIndex, length);
+            }
+
+            void AddReference()
+            {
+                int references;
+                do
+                {
+                    references = _references;
+                    if(references < 0)
+                        throw gcnew ObjectDisposedException("Match", "The input of a disposed Match cannot be searched.");
+                }
+                while(references != Interlocked::CompareExchange(_references, references + 1, references));
+            }
+
+            void Release()
+            {
+                /* A concurrent AddReference() between the two steps keeps the input alive. */
+                if(!Interlocked::Decrement(_references) && !Interlocked::CompareExchange(_references, -1, 0))
+                    delete _handle;
+            }
+
+            ~RegexInput()
+            {
+                _references = -1;
+                delete _handle;
             }
     };
 }
@@ -0,0 +1,160 @@
+﻿/*
+ *  Re2.Net Copyright ©2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#include "CaptureBuffer.h"
+#include "Match.h"
+#include "Regex.h"
+#include "RegexScanner.h"
+
+
+namespace Re2
+{
+namespace Net
+{
+    /* The stitch buffer holds a whole tail and as much again of the next buffer, and must fit in an array. */
+    static const int MaxScannerMatchLength = Int32::MaxValue / 2 - 2;
+
+    RegexScanner::RegexScanner(Regex^ regex, int maxMatchLength)
+    {
+        if(!regex)
+            throw gcnew ArgumentNullException("regex", "Value cannot be null.");
+        if(maxMatchLength < 1 || maxMatchLength > MaxScannerMatchLength)
+            throw gcnew ArgumentOutOfRangeException("maxMatchLength", "Maximum match length cannot be less than 1 or greater than 1073741821.");
+
+        _regex          = regex;
+        _maxMatchLength = maxMatchLength;
+        _tail           = gcnew array<Byte>(maxMatchLength + 2);
+        _stitch         = gcnew array<Byte>(2 * (maxMatchLength + 2));
+        _matches        = gcnew List<Match^>();
+        _captures       = regex->_newCaptureBuffer();
+        _tailLength     = 0;
+        _tailStart      = 0;
+        _position       = 0;
+        _length         = 0;
+        _finished       = false;
+    }
+
+    /*
+     *  Adds the matches in data that start at or after _position and before cutoff, and moves _position on
+     *  to cutoff. data begins at index origin of the whole input.
+     */
+    void RegexScanner::_scanWindow(const char* data, int length, Int64 origin, Int64 cutoff)
+    {
+        StringPiece text(data, length);
+
+        while(_position < cutoff && _position - origin <= length)
+        {
+            Match^ match = _regex->_scan(text, _position - origin, origin, _captures);
+
+            /* A match at or after cutoff may not be complete yet; the next window finds it again. */
+            if(!match->Success || match->LongIndex >= cutoff)
+                break;
+
+            _matches->Add(match);
+            _position = match->LongIndex + (match->LongLength ? match->LongLength : 1);
+        }
+
+        if(_position < cutoff)
+            _position = cutoff;
+    }
+
+    array<Match^>^ RegexScanner::_takeMatches()
+    {
+        if(!_matches->Count)
+            return Array::Empty<Match^>();
+
+        array<Match^>^ rv = _matches->ToArray();
+        _matches->Clear();
+
+        return rv;
+    }
+
+    array<Match^>^ RegexScanner::Append(array<Byte>^ buffer, int offset, int count)
+    {
+        if(!buffer)
+            throw gcnew ArgumentNullException("buffer", "Value cannot be null.");
+        if(offset < 0 || offset > buffer->Length)
+            throw gcnew ArgumentOutOfRangeException("offset", "Offset cannot be less than 0 or greater than buffer length.");
+        if(count < 0 || count > buffer->Length - offset)
+            throw gcnew ArgumentOutOfRangeException("count", "Count cannot be less than 0 or greater than the rest of the buffer.");
+        if(_finished)
+            throw gcnew InvalidOperationException("The end of the input has already been reached.");
+        if(!count)
+            return Array::Empty<Match^>();
+
+        Int64 start = _length;
+        _length += count;
+
+        if(_tailLength)
+        {
+            int head = count < _maxMatchLength + 2 ? count : _maxMatchLength + 2;
+            Array::Copy(_tail, 0, _stitch, 0, _tailLength);
+            Array::Copy(buffer, offset, _stitch, _tailLength, head);
+
+            pin_ptr<Byte> stitch = &_stitch[0];
+            this->_scanWindow((const char*)stitch, _tailLength + head, _tailStart, _tailStart + _tailLength + head - _maxMatchLength - 1);
+        }
+
+        {
+            pin_ptr<Byte> data = &buffer[offset];
+            this->_scanWindow((const char*)data, count, start, _length - _maxMatchLength - 1);
+        }
+
+        /*
+         *  Keep everything from one byte before _position, which _scanWindow() has left no more than
+         *  _maxMatchLength + 1 bytes from the end. Part of it may still come from the old tail when
+         *  buffer is short.
+         */
+        Int64 keep       = _position > 0 ? _position - 1 : 0;
+        int   kept       = static_cast<int>(_length - keep);
+        int   fromBuffer = kept < count ? kept : count;
+        int   fromTail   = kept - fromBuffer;
+
+        Array::Copy(_tail, _tailLength - fromTail, _tail, 0, fromTail);
+        Array::Copy(buffer, offset + count - fromBuffer, _tail, fromTail, fromBuffer);
+
+        _tailLength = kept;
+        _tailStart  = keep;
+
+        return this->_takeMatches();
+    }
+
+    array<Match^>^ RegexScanner::Append(array<Byte>^ buffer)
+    {
+        if(!buffer)
+            throw gcnew ArgumentNullException("buffer", "Value cannot be null.");
+
+        return this->Append(buffer, 0, buffer->Length);
+    }
+
+    array<Match^>^ RegexScanner::Finish()
+    {
+        if(_finished)
+            return Array::Empty<Match^>();
+
+        _finished = true;
+
+        /* As in Regex::_nextMatch(), an empty match may still be found after the last byte. */
+        pin_ptr<Byte> tail = &_tail[0];
+        this->_scanWindow((const char*)tail, _tailLength, _tailStart, _length + 1);
+
+        return this->_takeMatches();
+    }
+
+    Int64 RegexScanner::Length::get()
+    {
+        return _length;
+    }
+
+    Int64 RegexScanner::Position::get()
+    {
+        /* Finish() leaves _position one past the end, where an empty match may have been looked for. */
+        return _position < _length ? _position : _length;
+    }
+}
+}
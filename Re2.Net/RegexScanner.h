@@ -0,0 +1,166 @@
+﻿/*
+ *  Re2.Net Copyright ©2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#include "CaptureBuffer.h"
+#include "Regex.h"
+#include "Match.h"
+
+
+namespace Re2
+{
+namespace Net
+{
+    using namespace System;
+
+    using System::Collections::Generic::List;
+
+    ref class CaptureBuffer;
+    ref class Regex;
+    ref class Match;
+
+
+    /*
+     *  Finds the matches of a Regex in an input that arrives as a series of byte buffers, searching each
+     *  buffer in place rather than joining them into one. Matches are assumed to be no longer than
+     *  maxMatchLength bytes. Under that assumption a match that starts more than maxMatchLength bytes
+     *  before the end of a buffer is known to be complete, and the only bytes that need to be kept are
+     *  the last maxMatchLength + 2 of the buffer: the unsettled tail, plus one byte of context before it
+     *  so that '^' and '\b' behave as they would in the joined input. A match that straddles a boundary is
+     *  found in a small stitch buffer holding that tail and the head of the next buffer.
+     *
+     *  Nothing before _position is searched again, so the cost of each Append() is proportional to the
+     *  bytes appended, plus at most one stitch buffer.
+     *
+     *  All indices are counted from the start of the whole input. Matches are detached (see
+     *  Match::Detach()), since the buffers they were found in are gone by the time they're used.
+     *  Regex::Matches() over segments and Regex::MatchesAsync() are both built on the scanner.
+     */
+
+    /// <summary>
+    ///     Searches an input that arrives a buffer at a time, such as a log file that is still being written, reporting each match
+    ///     once the input that follows it is known.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///         Each call to <see cref="Append(array&lt;Byte&gt;^, int, int)"/> searches only the bytes it is given, together with
+    ///         at most <c>maxMatchLength + 2</c> bytes kept from before them, and returns the matches that the new bytes have
+    ///         settled. The matches are the same, with the same indices, as a search of all of the input at once would find,
+    ///         provided that no match is longer than <c>maxMatchLength</c> bytes. A longer match may be missed or cut short where
+    ///         it crosses from one buffer into the next.
+    ///     </para>
+    ///     <para>
+    ///         A match that ends within <c>maxMatchLength</c> bytes of the input received so far isn't settled until more input
+    ///         arrives, or until <see cref="Finish"/> is called. <c>$</c> and <c>\z</c> only match at the end of the input in
+    ///         <see cref="Finish"/>.
+    ///     </para>
+    ///     <para>
+    ///         Matches hold copies of their own text, so buffers can be reused as soon as <c>Append</c> returns. A scanner is not
+    ///         safe for use by more than one thread at a time.
+    ///     </para>
+    /// </remarks>
+    public ref class RegexScanner sealed
+    {
+        private:
+
+            initonly Regex^         _regex;
+            initonly int            _maxMatchLength;
+            initonly array<Byte>^   _tail;
+            initonly array<Byte>^   _stitch;
+            initonly List<Match^>^  _matches;
+            initonly CaptureBuffer^ _captures;
+
+            int   _tailLength;
+            Int64 _tailStart;
+            Int64 _position;
+            Int64 _length;
+            bool  _finished;
+
+            void _scanWindow(const char* data, int length, Int64 origin, Int64 cutoff);
+
+            array<Match^>^ _takeMatches();
+
+
+        public:
+
+            /// <summary>
+            ///     Initializes a new instance of the <see cref="RegexScanner"/> class for the specified regular expression.
+            /// </summary>
+            /// <param name="regex">The regular expression to search for.</param>
+            /// <param name="maxMatchLength">The greatest number of bytes that a match can span.</param>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="regex"/> is <c>null</c>.
+            /// </exception>
+            /// <exception cref="System::ArgumentOutOfRangeException">
+            ///     <paramref name="maxMatchLength"/> is less than 1 or greater than 1073741821.
+            /// </exception>
+            RegexScanner(Regex^ regex, int maxMatchLength);
+
+
+            /// <summary>
+            ///     Searches the next part of the input.
+            /// </summary>
+            /// <param name="buffer">The array that holds the next part of the input.</param>
+            /// <param name="offset">The index in <paramref name="buffer"/> at which the part begins.</param>
+            /// <param name="count">The number of bytes in the part.</param>
+            /// <returns>The matches settled by the new bytes, in order. The array is empty if there are none.</returns>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="buffer"/> is <c>null</c>.
+            /// </exception>
+            /// <exception cref="System::ArgumentOutOfRangeException">
+            ///     <paramref name="offset"/> or <paramref name="count"/> is less than zero, or together they identify a range
+            ///     outside <paramref name="buffer"/>.
+            /// </exception>
+            /// <exception cref="System::InvalidOperationException">
+            ///     <see cref="Finish"/> has already been called.
+            /// </exception>
+            array<Match^>^ Append(array<Byte>^ buffer, int offset, int count);
+
+
+            /// <summary>
+            ///     Searches the next part of the input.
+            /// </summary>
+            /// <param name="buffer">The next part of the input.</param>
+            /// <returns>The matches settled by the new bytes, in order. The array is empty if there are none.</returns>
+            /// <exception cref="System::ArgumentNullException">
+            ///     <paramref name="buffer"/> is <c>null</c>.
+            /// </exception>
+            /// <exception cref="System::InvalidOperationException">
+            ///     <see cref="Finish"/> has already been called.
+            /// </exception>
+            array<Match^>^ Append(array<Byte>^ buffer);
+
+
+            /// <summary>
+            ///     Marks the end of the input, and searches what remains unsettled.
+            /// </summary>
+            /// <returns>
+            ///     The remaining matches, in order, including any that only match at the end of the input. The array is empty if
+            ///     there are none, or if the method has already been called.
+            /// </returns>
+            array<Match^>^ Finish();
+
+
+            /// <summary>
+            ///     Gets the number of bytes appended so far.
+            /// </summary>
+            property Int64 Length
+            {
+                Int64 get();
+            }
+
+
+            /// <summary>
+            ///     Gets the index at which the search will resume. Every match that begins before it has been returned.
+            /// </summary>
+            property Int64 Position
+            {
+                Int64 get();
+            }
+    };
+}
+}
@@ -0,0 +1,137 @@
+﻿/*
+ *  Re2.Net Copyright ©2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#include "Match.h"
+#include "MatchCollection.h"
+#include "Regex.h"
+#include "RegexScanner.h"
+#include "StreamSearch.h"
+
+
+namespace Re2
+{
+namespace Net
+{
+    StreamSearch::StreamSearch(Regex^ regex, Stream^ stream, int bufferSize, int maxMatchLength, Action<Match^>^ onMatch)
+    {
+        if(!stream)
+            throw gcnew ArgumentNullException("input", "Value cannot be null.");
+        if(!stream->CanRead)
+            throw gcnew ArgumentException("Stream does not support reading.", "input");
+        if(bufferSize < 1)
+            throw gcnew ArgumentOutOfRangeException("bufferSize", "Buffer size cannot be less than 1.");
+
+        _stream     = stream;
+        _scanner    = gcnew RegexScanner(regex, maxMatchLength);
+        _buffers    = gcnew array<array<Byte>^> { gcnew array<Byte>(bufferSize), gcnew array<Byte>(bufferSize) };
+        _onMatch    = onMatch;
+        _collection = onMatch ? nullptr : gcnew MatchCollection(Match::Empty);
+        _count      = onMatch ? gcnew TaskCompletionSource<Int64>() : nullptr;
+        _matches    = onMatch ? nullptr : gcnew TaskCompletionSource<MatchCollection^>();
+        _current    = 0;
+        _found      = 0;
+    }
+
+    Task<Int64>^ StreamSearch::Start(Regex^ regex, Stream^ stream, int bufferSize, int maxMatchLength, Action<Match^>^ onMatch)
+    {
+        if(!onMatch)
+            throw gcnew ArgumentNullException("match", "Value cannot be null.");
+
+        StreamSearch^ search = gcnew StreamSearch(regex, stream, bufferSize, maxMatchLength, onMatch);
+        search->_start();
+
+        return search->_count->Task;
+    }
+
+    Task<MatchCollection^>^ StreamSearch::Start(Regex^ regex, Stream^ stream, int bufferSize, int maxMatchLength)
+    {
+        StreamSearch^ search = gcnew StreamSearch(regex, stream, bufferSize, maxMatchLength, nullptr);
+        search->_start();
+
+        return search->_matches->Task;
+    }
+
+    void StreamSearch::_start()
+    {
+        _stream->ReadAsync(_buffers[0], 0, _buffers[0]->Length)->ContinueWith(gcnew Action<Task<int>^>(this, &StreamSearch::_read));
+    }
+
+    void StreamSearch::_read(Task<int>^ read)
+    {
+        try
+        {
+            if(read->IsFaulted)
+            {
+                this->_fail(read->Exception->InnerExceptions);
+                return;
+            }
+            if(read->IsCanceled)
+            {
+                if(_count)
+                    _count->TrySetCanceled();
+                else
+                    _matches->TrySetCanceled();
+                return;
+            }
+
+            int count = read->Result;
+            if(!count)
+            {
+                this->_deliver(_scanner->Finish());
+                this->_succeed();
+                return;
+            }
+
+            array<Byte>^ buffer = _buffers[_current];
+            _current ^= 1;
+
+            Task<int>^ next = _stream->ReadAsync(_buffers[_current], 0, _buffers[_current]->Length);
+
+            this->_deliver(_scanner->Append(buffer, 0, count));
+
+            /*
+             *  Not ExecuteSynchronously: a Stream that completes its reads synchronously would otherwise run every
+             *  chunk on one ever-deeper stack.
+             */
+            next->ContinueWith(gcnew Action<Task<int>^>(this, &StreamSearch::_read));
+        }
+        catch(Exception^ e)
+        {
+            this->_fail(gcnew array<Exception^> { e });
+        }
+    }
+
+    void StreamSearch::_deliver(array<Match^>^ matches)
+    {
+        for(int i = 0; i < matches->Length; i++)
+        {
+            ++_found;
+            if(_onMatch)
+                _onMatch(matches[i]);
+            else
+                _collection->_matches->Add(matches[i]);
+        }
+    }
+
+    void StreamSearch::_succeed()
+    {
+        if(_count)
+            _count->TrySetResult(_found);
+        else
+            _matches->TrySetResult(_collection);
+    }
+
+    void StreamSearch::_fail(IEnumerable<Exception^>^ exceptions)
+    {
+        if(_count)
+            _count->TrySetException(exceptions);
+        else
+            _matches->TrySetException(exceptions);
+    }
+}
+}
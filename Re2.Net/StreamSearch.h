@@ -0,0 +1,72 @@
+﻿/*
+ *  Re2.Net Copyright ©2014 Colt Blackmore. All Rights Reserved.
+ *
+ *  See Regex.h for licensing and contact information.
+ */
+
+#pragma once
+
+#include "Match.h"
+#include "MatchCollection.h"
+#include "Regex.h"
+#include "RegexScanner.h"
+
+
+namespace Re2
+{
+namespace Net
+{
+    using namespace System;
+    using namespace System::IO;
+    using namespace System::Threading::Tasks;
+
+    using System::Collections::Generic::IEnumerable;
+
+    ref class Match;
+    ref class MatchCollection;
+    ref class Regex;
+    ref class RegexScanner;
+
+
+    /*
+     *  Runs Regex::MatchesAsync(): reads a Stream a chunk at a time and feeds each chunk to a RegexScanner.
+     *  There are two buffers, which take turns: the read of the next chunk is started before the current one
+     *  is searched, so that the I/O and the search overlap. The continuation that searches the next chunk is
+     *  only attached once the current search is done, so the scanner and each buffer are only ever in use by
+     *  one thread at a time, and there is never more than one read outstanding on the Stream.
+     *
+     *  Matches are handed to the callback, or added to the collection, as soon as the scanner has settled them.
+     *  The scanner doesn't keep them, so with a callback the memory used doesn't grow with the Stream.
+     */
+    private ref class StreamSearch sealed
+    {
+        private:
+
+            initonly Stream^                                 _stream;
+            initonly RegexScanner^                           _scanner;
+            initonly array<array<Byte>^>^                    _buffers;
+            initonly Action<Match^>^                         _onMatch;
+            initonly MatchCollection^                        _collection;
+            initonly TaskCompletionSource<Int64>^            _count;
+            initonly TaskCompletionSource<MatchCollection^>^ _matches;
+
+            int   _current;
+            Int64 _found;
+
+            StreamSearch(Regex^ regex, Stream^ stream, int bufferSize, int maxMatchLength, Action<Match^>^ onMatch);
+
+            void _start();
+            void _read(Task<int>^ read);
+            void _deliver(array<Match^>^ matches);
+            void _succeed();
+            void _fail(IEnumerable<Exception^>^ exceptions);
+
+
+        internal:
+
+            static Task<Int64>^ Start(Regex^ regex, Stream^ stream, int bufferSize, int maxMatchLength, Action<Match^>^ onMatch);
+
+            static Task<MatchCollection^>^ Start(Regex^ regex, Stream^ stream, int bufferSize, int maxMatchLength);
+    };
+}
+}